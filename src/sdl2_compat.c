@@ -212,17 +212,18 @@ do { \
 #define PROP_WINDOW_EXPECTED_HEIGHT "sdl2-compat.window.expected_height"
 #define PROP_WINDOW_EXPECTED_SCALE "sdl2-compat.window.expected_scale"
 #define PROP_WINDOW_GAMMA_RAMP "sdl2-compat.window.gamma_ramp"
+#define PROP_WINDOW_GAMMA_STATE_POINTER "sdl2-compat.window.gamma_state"
 #define PROP_WINDOW_MOUSE_GRABBED "sdl2-compat.window.mouse_grabbed"
 #define PROP_WINDOW_KEYBOARD_GRABBED "sdl2-compat.window.keyboard_grabbed"
-#define PROP_RENDERER_BATCHING "sdl2-compat.renderer.batching"
+#define PROP_RENDERER_STATE_POINTER "sdl2-compat.renderer.state"
 #define PROP_RENDERER_RELATIVE_SCALING "sdl2-compat.renderer.relative-scaling"
 #define PROP_RENDERER_INTEGER_SCALE "sdl2-compat.renderer.integer_scale"
-#define PROP_TEXTURE_SCALE_MODE "sdl2-compat.texture.scale_mode"
+#define PROP_RENDERER_TEXTURE_POOL_POINTER "sdl2-compat.renderer.texture_pool"
+#define PROP_TEXTURE_INFO_POINTER "sdl2-compat.texture.info"
+#define PROP_TEXTURE_USERDATA_POINTER "sdl2-compat.texture.userdata"
 #define PROP_SURFACE2 "sdl2-compat.surface2"
 #define PROP_STREAM2 "sdl2-compat.stream2"
 
-#define PROP_TEXTURE_SCALE_MODE_UNAVAILABLE (-42)
-
 
 static bool WantDebugLogging = false;
 static SDL_InitState InitSDL2CompatGlobals;
@@ -2652,6 +2653,12 @@ SDL_PushEvent(SDL2_Event *event2)
 }
 
 static int Display_IDToIndex(SDL_DisplayID displayID);
+static void SubmitSprites(SDL_Renderer *renderer);
+static void ResetPixelFormatDetailsCache(void);
+static void FreePaletteMaps(void);
+static void ForgetGLBindFuncs(SDL_GLContext context);
+static void ForgetRWopsBridges(SDL2_RWops *rwops2);
+static void ResetControllerMappingHashes(void);
 
 static SDL2_WindowEventID
 WindowEventType3To2(Uint32 event_type3)
@@ -2942,6 +2949,8 @@ EventFilter3to2(void *userdata, SDL_Event *event3)
                     renderer = SDL_GetRenderer(window);
                     if (renderer) {
                         SDL_RendererLogicalPresentation mode;
+
+                        SubmitSprites(renderer);  /* they were drawn at the old scale. */
                         if (SDL3_GetRenderLogicalPresentation(renderer, NULL, NULL, &mode) &&
                             mode == SDL_LOGICAL_PRESENTATION_DISABLED) {
                             SDL_RenderSetViewport(renderer, NULL);
@@ -3574,259 +3583,1226 @@ SDL_FreeRW(SDL2_RWops *rwops2)
         rwops2->hidden.sdl3.iostrm) {
         SDL3_CloseIO(rwops2->hidden.sdl3.iostrm);
         rwops2->hidden.sdl3.iostrm = NULL;
+    } else {
+        ForgetRWopsBridges(rwops2);
     }
     SDL3_free(rwops2);
 }
 
-SDL_DECLSPEC SDL2_RWops *SDLCALL
-SDL_RWFromFile(const char *file, const char *mode)
+/* Opt-in read-ahead for SDL_RWFromFile(), see SDL2COMPAT_RWFROMFILE_READAHEAD in README.md.
+   Loaders that parse a file a few bytes at a time get those bytes from this buffer instead of the file. */
+#define SDL2_READAHEAD_SIZE (64 * 1024)
+
+typedef struct SDL2_ReadAheadStream
 {
-    SDL2_RWops *rwops2 = NULL;
+    SDL_IOStream *io;
+    Uint8 *buffer;
+    size_t len;  /* bytes in buffer, io is positioned just past them. */
+    size_t pos;  /* next unread byte in buffer. */
+    Uint64 reads;
+    Uint64 buffered_reads;  /* reads served entirely from the buffer. */
+} SDL2_ReadAheadStream;
 
-    /* match some SDL2 Apple-specific quirks that were removed from SDL3. */
-    #if defined(SDL_PLATFORM_APPLE)
-    char *adjusted_path = NULL;
-    /* If the file mode is writable, skip all the bundle stuff because generally the bundle is read-only. */
-    if (mode && (SDL3_strchr(mode, 'r') != NULL) && SDL3_GetHintBoolean(SDL_HINT_APPLE_RWFROMFILE_USE_RESOURCES, true)) {
-        const char *base = SDL3_GetBasePath();
-        if (base) {
-            if (SDL3_asprintf(&adjusted_path, "%s%s", base, file) < 0) {
-                return NULL;
+/* Drops whatever hasn't been read yet and puts io back where the reader thinks it is. */
+static bool DiscardReadAhead(SDL2_ReadAheadStream *stream)
+{
+    if (stream->pos < stream->len) {
+        if (SDL3_SeekIO(stream->io, -(Sint64)(stream->len - stream->pos), SDL_IO_SEEK_CUR) < 0) {
+            return false;
+        }
+    }
+    stream->len = stream->pos = 0;
+    return true;
+}
+
+static Sint64 SDLCALL
+ReadAhead_size(void *userdata)
+{
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    return SDL3_GetIOSize(stream->io);
+}
+
+static Sint64 SDLCALL
+ReadAhead_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    const Sint64 unread = (Sint64)(stream->len - stream->pos);
+
+    if (whence == SDL_IO_SEEK_CUR) {
+        /* Stay in the buffer if we can. This is also how SDL_RWtell() asks for the position. */
+        if (offset >= -(Sint64)stream->pos && offset <= unread) {
+            const Sint64 end = SDL3_TellIO(stream->io);
+            if (end < 0) {
+                return -1;
             }
-            rwops2 = RWops3to2(SDL3_IOFromFile(adjusted_path, mode), SDL_RWOPS_PLATFORM_FILE);
-            SDL3_free(adjusted_path);
+            stream->pos = (size_t)((Sint64)stream->pos + offset);
+            return end - (Sint64)(stream->len - stream->pos);
         }
+        offset -= unread;  /* io is ahead of the reader by the unread bytes. */
     }
-    if (!rwops2) {
-        rwops2 = RWops3to2(SDL3_IOFromFile(file, mode), SDL_RWOPS_PLATFORM_FILE);
+    stream->len = stream->pos = 0;
+    return SDL3_SeekIO(stream->io, offset, whence);
+}
+
+static size_t SDLCALL
+ReadAhead_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    ++stream->reads;
+    if (size <= stream->len - stream->pos) {
+        ++stream->buffered_reads;
     }
-    #else
-    rwops2 = RWops3to2(SDL3_IOFromFile(file, mode), SDL_RWOPS_PLATFORM_FILE);
-    #endif
 
-    if (rwops2) {
-        const SDL_PropertiesID props = SDL3_GetIOProperties(rwops2->hidden.sdl3.iostrm);
-        if (props) {
-            void *handle = NULL;
-            #if defined(SDL_PLATFORM_WINDOWS)
-            if (!handle) {
-                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_WINDOWS_HANDLE_POINTER, NULL);
-                if (handle) {
-                    rwops2->hidden.windowsio.h = handle;
-                }
+    while (size > 0) {
+        size_t amount = stream->len - stream->pos;
+        if (amount > 0) {
+            if (amount > size) {
+                amount = size;
             }
-            #elif defined(SDL_PLATFORM_ANDROID)
-            if (!handle) {
-                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_ANDROID_AASSET_POINTER, NULL);
-                if (handle) {
-                    rwops2->hidden.androidio.asset = handle;
-                }
+            SDL3_memcpy(dst, stream->buffer + stream->pos, amount);
+            stream->pos += amount;
+            dst += amount;
+            size -= amount;
+            total += amount;
+        } else if (size >= SDL2_READAHEAD_SIZE) {
+            /* big reads go straight to the file. */
+            amount = SDL3_ReadIO(stream->io, dst, size);
+            total += amount;
+            if (amount < size) {
+                *status = SDL3_GetIOStatus(stream->io);
             }
-            #endif
-
-            if (!handle) {
-                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_STDIO_FILE_POINTER, NULL);
-                if (handle) {
-                    rwops2->hidden.stdio.autoclose = SDL2_FALSE;
-                    rwops2->hidden.stdio.fp = handle;
-                }
+            break;
+        } else {
+            stream->pos = 0;
+            stream->len = SDL3_ReadIO(stream->io, stream->buffer, SDL2_READAHEAD_SIZE);
+            if (stream->len == 0) {
+                *status = SDL3_GetIOStatus(stream->io);
+                break;
             }
         }
     }
-    return rwops2;
+    return total;
 }
 
-SDL_DECLSPEC SDL2_RWops *SDLCALL
-SDL_RWFromMem(void *mem, int size)
+static size_t SDLCALL
+ReadAhead_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
-    if (size <= 0) {
-        SDL3_InvalidParamError("size");
-        return NULL;
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    size_t amount;
+
+    /* "r+" streams can write, too. */
+    if (!DiscardReadAhead(stream)) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+    amount = SDL3_WriteIO(stream->io, ptr, size);
+    if (amount < size) {
+        *status = SDL3_GetIOStatus(stream->io);
     }
-    return RWops3to2(SDL3_IOFromMem(mem, size), SDL_RWOPS_MEMORY);
+    return amount;
 }
 
-SDL_DECLSPEC SDL2_RWops *SDLCALL
-SDL_RWFromConstMem(const void *mem, int size)
+static bool SDLCALL
+ReadAhead_flush(void *userdata, SDL_IOStatus *status)
 {
-    if (size <= 0) {
-        SDL3_InvalidParamError("size");
-        return NULL;
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    if (!SDL3_FlushIO(stream->io)) {
+        *status = SDL3_GetIOStatus(stream->io);
+        return false;
     }
-    return RWops3to2(SDL3_IOFromConstMem(mem, size), SDL_RWOPS_MEMORY_RO);
+    return true;
 }
 
-SDL_DECLSPEC Sint64 SDLCALL
-SDL_RWsize(SDL2_RWops *rwops2)
+static bool SDLCALL
+ReadAhead_close(void *userdata)
 {
-    return rwops2->size(rwops2);
-}
+    SDL2_ReadAheadStream *stream = (SDL2_ReadAheadStream *)userdata;
+    bool result;
 
-SDL_DECLSPEC Sint64 SDLCALL
-SDL_RWseek(SDL2_RWops *rwops2, Sint64 offset, int whence)
-{
-    return rwops2->seek(rwops2, offset, whence);
+    if (WantDebugLogging && stream->reads > 0) {
+        SDL3_Log("sdl2-compat: file read-ahead served %" SDL_PRIu64 " of %" SDL_PRIu64 " reads (%d%%) from its buffer.",
+                 stream->buffered_reads, stream->reads, (int)((stream->buffered_reads * 100) / stream->reads));
+    }
+
+    result = SDL3_CloseIO(stream->io);
+    SDL3_free(stream->buffer);
+    SDL3_free(stream);
+    return result;
 }
 
-SDL_DECLSPEC Sint64 SDLCALL
-SDL_RWtell(SDL2_RWops *rwops2)
-{
-    return rwops2->seek(rwops2, 0, SDL_IO_SEEK_CUR);
+static SDL_IOStream *
+OpenFileIO(const char *file, const char *mode)
+{
+    SDL_IOStream *io = SDL3_IOFromFile(file, mode);
+    SDL2_ReadAheadStream *stream;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *result;
+
+    if (!io || mode[0] != 'r' || !SDL3_GetHintBoolean("SDL2COMPAT_RWFROMFILE_READAHEAD", false)) {
+        return io;
+    }
+
+    /* if any of this fails, just use the file without read-ahead. */
+    stream = (SDL2_ReadAheadStream *)SDL3_calloc(1, sizeof(*stream));
+    if (!stream) {
+        return io;
+    }
+    stream->buffer = (Uint8 *)SDL3_malloc(SDL2_READAHEAD_SIZE);
+    if (!stream->buffer) {
+        SDL3_free(stream);
+        return io;
+    }
+    stream->io = io;
+
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = ReadAhead_size;
+    iface.seek = ReadAhead_seek;
+    iface.read = ReadAhead_read;
+    iface.write = ReadAhead_write;
+    iface.flush = ReadAhead_flush;
+    iface.close = ReadAhead_close;
+    result = SDL3_OpenIO(&iface, stream);
+    if (!result) {
+        SDL3_free(stream->buffer);
+        SDL3_free(stream);
+        return io;
+    }
+    return result;
 }
 
-SDL_DECLSPEC size_t SDLCALL
-SDL_RWread(SDL2_RWops *rwops2, void *ptr, size_t size, size_t maxnum)
+/* Opt-in background prefetch for read-only SDL_RWFromFile(), see SDL2COMPAT_RWFROMFILE_PREFETCH in README.md.
+   SDL3's async I/O loads the blocks after the app's position while it works on what it already read. */
+#define SDL2_PREFETCH_BLOCK_SIZE (256 * 1024)
+#define SDL2_PREFETCH_BLOCKS 4  /* at most 1 megabyte per file. */
+
+typedef struct SDL2_PrefetchBlock
 {
-    return rwops2->read(rwops2, ptr, size, maxnum);
-}
+    Uint8 *data;
+    Uint64 offset;
+    Uint64 len;  /* bytes requested while pending, bytes read once ready. */
+    bool pending;
+    bool ready;
+    bool failed;
+    bool discarded;  /* the app went elsewhere while this was pending, so it's dropped when it finishes. */
+} SDL2_PrefetchBlock;
 
-SDL_DECLSPEC size_t SDLCALL
-SDL_RWwrite(SDL2_RWops *rwops2, const void *ptr, size_t size, size_t num)
+typedef struct SDL2_PrefetchStream
 {
-    return rwops2->write(rwops2, ptr, size, num);
-}
+    SDL_AsyncIO *asyncio;
+    SDL_AsyncIOQueue *queue;
+    Uint8 *data;
+    Sint64 size;
+    Uint64 pos;
+    Uint64 next_offset;  /* where the next prefetch starts. */
+    int num_pending;
+    Uint64 reads;
+    Uint64 stalled_reads;
+    Uint64 stall_ns;
+    SDL2_PrefetchBlock blocks[SDL2_PREFETCH_BLOCKS];
+} SDL2_PrefetchStream;
 
-SDL_DECLSPEC int SDLCALL
-SDL_RWclose(SDL2_RWops *rwops2)
+static void FinishPrefetch(SDL2_PrefetchStream *stream, const SDL_AsyncIOOutcome *outcome)
 {
-    return rwops2->close(rwops2);
+    SDL2_PrefetchBlock *block = (SDL2_PrefetchBlock *)outcome->userdata;
+
+    if (outcome->type != SDL_ASYNCIO_TASK_READ || !block) {
+        return;
+    }
+    stream->num_pending--;
+    block->pending = false;
+    if (block->discarded) {
+        block->discarded = false;
+        return;
+    }
+    block->ready = true;
+    block->failed = (outcome->result != SDL_ASYNCIO_COMPLETE);
+    block->len = outcome->bytes_transferred;
 }
 
-SDL_DECLSPEC Uint8 SDLCALL
-SDL_ReadU8(SDL2_RWops *rwops2)
+static bool WaitPrefetch(SDL2_PrefetchStream *stream)
 {
-    Uint8 x = 0;
-    SDL_RWread(rwops2, &x, sizeof (x), 1);
-    return x;
+    SDL_AsyncIOOutcome outcome;
+    const Uint64 start = SDL3_GetTicksNS();
+    const bool result = SDL3_WaitAsyncIOResult(stream->queue, &outcome, -1);
+
+    stream->stall_ns += SDL3_GetTicksNS() - start;
+    if (result) {
+        FinishPrefetch(stream, &outcome);
+    }
+    return result;
 }
 
-SDL_DECLSPEC size_t SDLCALL
-SDL_WriteU8(SDL2_RWops *rwops2, Uint8 x)
+static void StartPrefetch(SDL2_PrefetchStream *stream)
 {
-    return SDL_RWwrite(rwops2, &x, sizeof(x), 1);
+    int i;
+    for (i = 0; i < SDL2_PREFETCH_BLOCKS && stream->next_offset < (Uint64)stream->size; i++) {
+        SDL2_PrefetchBlock *block = &stream->blocks[i];
+        if (block->ready && block->offset + block->len <= stream->pos) {
+            block->ready = false;  /* the app is past it. */
+        }
+        if (!block->pending && !block->ready) {
+            const Uint64 amount = SDL_min(SDL2_PREFETCH_BLOCK_SIZE, (Uint64)stream->size - stream->next_offset);
+            if (!SDL3_ReadAsyncIO(stream->asyncio, block->data, stream->next_offset, amount, stream->queue, block)) {
+                break;
+            }
+            block->offset = stream->next_offset;
+            block->len = amount;
+            block->pending = true;
+            stream->num_pending++;
+            stream->next_offset += amount;
+        }
+    }
 }
 
-#define DO_RWOPS_ENDIAN(order, bits)        \
-SDL_DECLSPEC Uint##bits SDLCALL             \
-SDL_Read##order##bits(SDL2_RWops *rwops2) { \
-    Uint##bits x = 0;                       \
-    SDL_RWread(rwops2, &x, sizeof (x), 1);  \
-    return SDL_Swap##bits##order(x);        \
-} \
-                                                           \
-SDL_DECLSPEC size_t SDLCALL                                \
-SDL_Write##order##bits(SDL2_RWops *rwops2, Uint##bits x) { \
-    x = SDL_Swap##bits##order(x);                          \
-    return SDL_RWwrite(rwops2, &x, sizeof(x), 1);          \
+/* Drops everything, so prefetching starts over at the app's position. Pending reads can't be canceled. */
+static void DiscardPrefetch(SDL2_PrefetchStream *stream)
+{
+    int i;
+    for (i = 0; i < SDL2_PREFETCH_BLOCKS; i++) {
+        SDL2_PrefetchBlock *block = &stream->blocks[i];
+        if (block->pending) {
+            block->discarded = true;
+        }
+        block->ready = false;
+    }
+    stream->next_offset = stream->pos;
 }
-DO_RWOPS_ENDIAN(LE, 16)
-DO_RWOPS_ENDIAN(BE, 16)
-DO_RWOPS_ENDIAN(LE, 32)
-DO_RWOPS_ENDIAN(BE, 32)
-DO_RWOPS_ENDIAN(LE, 64)
-DO_RWOPS_ENDIAN(BE, 64)
-#undef DO_RWOPS_ENDIAN
 
-/* stdio SDL_RWops was removed from SDL3, to prevent incompatible C runtime issues */
-#ifndef HAVE_STDIO_H
-SDL_DECLSPEC SDL2_RWops * SDLCALL
-SDL_RWFromFP(void *fp, SDL2_bool autoclose)
+static SDL2_PrefetchBlock *FindPrefetchBlock(SDL2_PrefetchStream *stream, Uint64 offset)
 {
-    SDL3_SetError("SDL not compiled with stdio support");
+    int i;
+    for (i = 0; i < SDL2_PREFETCH_BLOCKS; i++) {
+        SDL2_PrefetchBlock *block = &stream->blocks[i];
+        if ((block->ready || (block->pending && !block->discarded)) &&
+            offset >= block->offset && offset < block->offset + block->len) {
+            return block;
+        }
+    }
     return NULL;
 }
-#else
-
-/* !!! FIXME: SDL2 has a bunch of macro salsa to try and use the most 64-bit
-fseek, etc, and I'm avoiding that for now; this can change if it becomes a
-problem.  --ryan. */
-
-/* Functions to read/write stdio file pointers */
 
 static Sint64 SDLCALL
-stdio_size(SDL2_RWops *rwops2)
+Prefetch_size(void *userdata)
 {
-    Sint64 pos, size;
-
-    pos = SDL_RWseek(rwops2, 0, SDL_IO_SEEK_CUR);
-    if (pos < 0) {
-        return -1;
-    }
-    size = SDL_RWseek(rwops2, 0, SDL_IO_SEEK_END);
-
-    SDL_RWseek(rwops2, pos, SDL_IO_SEEK_SET);
-    return size;
+    SDL2_PrefetchStream *stream = (SDL2_PrefetchStream *)userdata;
+    return stream->size;
 }
 
 static Sint64 SDLCALL
-stdio_seek(SDL2_RWops *rwops2, Sint64 offset, int whence)
+Prefetch_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
 {
-    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
-    int stdiowhence;
+    SDL2_PrefetchStream *stream = (SDL2_PrefetchStream *)userdata;
+    Sint64 pos;
 
     switch (whence) {
     case SDL_IO_SEEK_SET:
-        stdiowhence = SEEK_SET;
+        pos = offset;
         break;
     case SDL_IO_SEEK_CUR:
-        stdiowhence = SEEK_CUR;
+        pos = (Sint64)stream->pos + offset;
         break;
     case SDL_IO_SEEK_END:
-        stdiowhence = SEEK_END;
+        pos = stream->size + offset;
         break;
     default:
         SDL3_SetError("Unknown value for 'whence'");
         return -1;
     }
 
-#if defined(FSEEK_OFF_MIN) && defined(FSEEK_OFF_MAX)
-    if (offset < (Sint64)(FSEEK_OFF_MIN) || offset > (Sint64)(FSEEK_OFF_MAX)) {
-        SDL3_SetError("Seek offset out of range");
+    if (pos < 0) {
+        SDL3_SetError("Seek before start of file");
         return -1;
     }
-#endif
-
-    if (fseek(fp, (long)offset, stdiowhence) == 0) {
-        Sint64 pos = ftell(fp);
-        if (pos < 0) {
-            SDL3_SetError("Couldn't get stream offset");
-            return -1;
-        }
-        return pos;
-    }
-    return SDL_Error(SDL_EFSEEK);
+    /* blocks that don't cover the new position are dropped on the next read. */
+    stream->pos = (Uint64)pos;
+    return pos;
 }
 
 static size_t SDLCALL
-stdio_read(SDL2_RWops *rwops2, void *ptr, size_t size, size_t maxnum)
+Prefetch_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
 {
-    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
-    size_t nread = fread(ptr, size, maxnum, fp);
-    if (nread == 0 && ferror(fp)) {
-        SDL_Error(SDL_EFREAD);
+    SDL2_PrefetchStream *stream = (SDL2_PrefetchStream *)userdata;
+    SDL_AsyncIOOutcome outcome;
+    Uint8 *dst = (Uint8 *)ptr;
+    const Uint64 stall_ns = stream->stall_ns;
+    bool restarted = false;
+    size_t total = 0;
+
+    while (stream->num_pending > 0 && SDL3_GetAsyncIOResult(stream->queue, &outcome)) {
+        FinishPrefetch(stream, &outcome);
     }
-    return nread;
+
+    while (size > 0) {
+        SDL2_PrefetchBlock *block;
+        size_t amount;
+
+        if (stream->pos >= (Uint64)stream->size) {
+            *status = SDL_IO_STATUS_EOF;
+            break;
+        }
+
+        StartPrefetch(stream);
+        block = FindPrefetchBlock(stream, stream->pos);
+        if (!block) {
+            if (stream->next_offset == stream->pos) {
+                /* no read could be started, wait for a discarded one to give its block back. */
+                if (stream->num_pending == 0 || !WaitPrefetch(stream)) {
+                    *status = SDL_IO_STATUS_ERROR;
+                    break;
+                }
+            } else if (restarted) {
+                *status = SDL_IO_STATUS_EOF;  /* the read at pos came back short, the file got smaller. */
+                break;
+            } else {
+                DiscardPrefetch(stream);
+                restarted = true;
+            }
+            continue;
+        } else if (block->pending) {
+            if (!WaitPrefetch(stream)) {
+                *status = SDL_IO_STATUS_ERROR;
+                break;
+            }
+            continue;
+        } else if (block->failed) {
+            *status = SDL_IO_STATUS_ERROR;
+            break;
+        }
+
+        amount = (size_t)SDL_min((Uint64)size, block->offset + block->len - stream->pos);
+        SDL3_memcpy(dst, block->data + (stream->pos - block->offset), amount);
+        stream->pos += amount;
+        dst += amount;
+        size -= amount;
+        total += amount;
+        restarted = false;
+        if (stream->pos == block->offset + block->len) {
+            block->ready = false;  /* used up, it can prefetch the next block. */
+        }
+    }
+
+    stream->reads++;
+    if (stream->stall_ns != stall_ns) {
+        stream->stalled_reads++;
+    }
+    return total;
 }
 
 static size_t SDLCALL
-stdio_write(SDL2_RWops *rwops2, const void *ptr, size_t size, size_t num)
+Prefetch_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
-    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
-    size_t nwrote = fwrite(ptr, size, num, fp);
-    if (nwrote == 0 && ferror(fp)) {
-        SDL_Error(SDL_EFWRITE);
-    }
-    return nwrote;
+    (void)userdata;
+    (void)ptr;
+    (void)size;
+    *status = SDL_IO_STATUS_READONLY;
+    return 0;
 }
 
-static int SDLCALL
-stdio_close(SDL2_RWops *rwops2)
+static bool SDLCALL
+Prefetch_close(void *userdata)
 {
-    int status = 0;
-    if (rwops2) {
-        if (rwops2->hidden.stdio.autoclose) {
-            if (fclose((FILE *)rwops2->hidden.stdio.fp) != 0) {
-                status = SDL_Error(SDL_EFWRITE);
+    SDL2_PrefetchStream *stream = (SDL2_PrefetchStream *)userdata;
+    bool result = true;
+
+    if (stream->asyncio) {
+        bool closing = SDL3_CloseAsyncIO(stream->asyncio, false, stream->queue, NULL);
+        SDL_AsyncIOOutcome outcome;
+
+        /* the blocks can't be freed until SDL3 is done with them. */
+        while ((closing || stream->num_pending > 0) && SDL3_WaitAsyncIOResult(stream->queue, &outcome, -1)) {
+            if (outcome.type == SDL_ASYNCIO_TASK_CLOSE) {
+                closing = false;
+                result = (outcome.result == SDL_ASYNCIO_COMPLETE);
+            } else {
+                FinishPrefetch(stream, &outcome);
+            }
+        }
+    }
+    if (stream->queue) {
+        SDL3_DestroyAsyncIOQueue(stream->queue);
+    }
+
+    if (WantDebugLogging && stream->reads > 0) {
+        SDL3_Log("sdl2-compat: file prefetch served %" SDL_PRIu64 " of %" SDL_PRIu64 " reads without waiting, waited %" SDL_PRIu64 " ms for the rest.",
+                 stream->reads - stream->stalled_reads, stream->reads, stream->stall_ns / SDL_NS_PER_MS);
+    }
+
+    SDL3_free(stream->data);
+    SDL3_free(stream);
+    return result;
+}
+
+static SDL_IOStream *
+OpenPrefetchIO(const char *file)
+{
+    SDL2_PrefetchStream *stream;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *result;
+    int i;
+
+    stream = (SDL2_PrefetchStream *)SDL3_calloc(1, sizeof(*stream));
+    if (!stream) {
+        return NULL;
+    }
+    stream->data = (Uint8 *)SDL3_malloc(SDL2_PREFETCH_BLOCKS * SDL2_PREFETCH_BLOCK_SIZE);
+    stream->queue = SDL3_CreateAsyncIOQueue();
+    stream->asyncio = stream->queue ? SDL3_AsyncIOFromFile(file, "r") : NULL;
+    stream->size = stream->asyncio ? SDL3_GetAsyncIOSize(stream->asyncio) : -1;
+    if (!stream->data || stream->size < 0) {
+        Prefetch_close(stream);
+        return NULL;
+    }
+    for (i = 0; i < SDL2_PREFETCH_BLOCKS; i++) {
+        stream->blocks[i].data = stream->data + (i * SDL2_PREFETCH_BLOCK_SIZE);
+    }
+
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = Prefetch_size;
+    iface.seek = Prefetch_seek;
+    iface.read = Prefetch_read;
+    iface.write = Prefetch_write;
+    iface.close = Prefetch_close;
+    result = SDL3_OpenIO(&iface, stream);
+    if (!result) {
+        Prefetch_close(stream);
+        return NULL;
+    }
+
+    StartPrefetch(stream);  /* get going while the app is still looking at the file's header. */
+    return result;
+}
+
+/* Opt-in memory mapping for read-only SDL_RWFromFile(), see SDL2COMPAT_RWFROMFILE_MMAP in README.md. */
+#if defined(_WIN32)
+#define SDL2COMPAT_HAVE_MMAP 1
+#elif (defined(SDL_PLATFORM_UNIX) || defined(__APPLE__)) && !defined(SDL_PLATFORM_ANDROID)
+#define SDL2COMPAT_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef SDL2COMPAT_HAVE_MMAP
+typedef struct SDL2_MappedFile
+{
+    const Uint8 *base;
+    size_t size;
+    size_t pos;
+} SDL2_MappedFile;
+
+/* Maps all of a regular file, or returns NULL so the caller can open it normally. */
+static const Uint8 *
+MapFile(const char *file, size_t *size)
+{
+#ifdef _WIN32
+    WCHAR *wfile = (WCHAR *)SDL3_iconv_string("UTF-16LE", "UTF-8", file, SDL3_strlen(file) + 1);
+    HANDLE handle;
+    HANDLE mapping;
+    LARGE_INTEGER filesize;
+    void *base = NULL;
+
+    if (!wfile) {
+        return NULL;
+    }
+    handle = CreateFileW(wfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    SDL3_free(wfile);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (GetFileType(handle) == FILE_TYPE_DISK && GetFileSizeEx(handle, &filesize) &&
+        filesize.QuadPart > 0 && (Uint64)filesize.QuadPart <= SDL_SIZE_MAX) {
+        mapping = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);  /* the view keeps the mapping alive. */
+            *size = (size_t)filesize.QuadPart;
+        }
+    }
+    CloseHandle(handle);
+    return (const Uint8 *)base;
+#else
+    struct stat statbuf;
+    void *base = NULL;
+    const int fd = open(file, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    /* pipes, devices, etc. don't map, and neither do empty files. */
+    if (fstat(fd, &statbuf) == 0 && S_ISREG(statbuf.st_mode) &&
+        statbuf.st_size > 0 && (Uint64)statbuf.st_size <= SDL_SIZE_MAX) {
+        base = mmap(NULL, (size_t)statbuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            base = NULL;
+        } else {
+            *size = (size_t)statbuf.st_size;
+        }
+    }
+    close(fd);
+    return (const Uint8 *)base;
+#endif
+}
+
+static Sint64 SDLCALL
+MappedFile_size(void *userdata)
+{
+    SDL2_MappedFile *mapped = (SDL2_MappedFile *)userdata;
+    return (Sint64)mapped->size;
+}
+
+static Sint64 SDLCALL
+MappedFile_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    SDL2_MappedFile *mapped = (SDL2_MappedFile *)userdata;
+    Sint64 pos;
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        pos = offset;
+        break;
+    case SDL_IO_SEEK_CUR:
+        pos = (Sint64)mapped->pos + offset;
+        break;
+    case SDL_IO_SEEK_END:
+        pos = (Sint64)mapped->size + offset;
+        break;
+    default:
+        SDL3_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+
+    /* like the file it replaces, it can't go before the start but can go past the end. */
+    if (pos < 0) {
+        SDL3_SetError("Seek before start of file");
+        return -1;
+    } else if ((Uint64)pos > SDL_SIZE_MAX) {
+        SDL3_SetError("Seek past end of address space");
+        return -1;
+    }
+    mapped->pos = (size_t)pos;
+    return pos;
+}
+
+static size_t SDLCALL
+MappedFile_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    SDL2_MappedFile *mapped = (SDL2_MappedFile *)userdata;
+    const size_t avail = (mapped->pos < mapped->size) ? (mapped->size - mapped->pos) : 0;
+
+    if (size > avail) {
+        size = avail;
+    }
+    if (size == 0) {
+        *status = SDL_IO_STATUS_EOF;
+        return 0;
+    }
+    SDL3_memcpy(ptr, mapped->base + mapped->pos, size);
+    mapped->pos += size;
+    return size;
+}
+
+static size_t SDLCALL
+MappedFile_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    (void)userdata;
+    (void)ptr;
+    (void)size;
+    *status = SDL_IO_STATUS_READONLY;
+    return 0;
+}
+
+static bool SDLCALL
+MappedFile_close(void *userdata)
+{
+    SDL2_MappedFile *mapped = (SDL2_MappedFile *)userdata;
+#ifdef _WIN32
+    UnmapViewOfFile(mapped->base);
+#else
+    munmap((void *)mapped->base, mapped->size);
+#endif
+    SDL3_free(mapped);
+    return true;
+}
+
+static SDL_IOStream *
+OpenMappedFileIO(const char *file)
+{
+    SDL2_MappedFile *mapped;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *result;
+    size_t size = 0;
+    const Uint8 *base = MapFile(file, &size);
+
+    if (!base) {
+        return NULL;
+    }
+    mapped = (SDL2_MappedFile *)SDL3_calloc(1, sizeof(*mapped));
+    if (!mapped) {
+        result = NULL;
+    } else {
+        mapped->base = base;
+        mapped->size = size;
+
+        SDL_INIT_INTERFACE(&iface);
+        iface.size = MappedFile_size;
+        iface.seek = MappedFile_seek;
+        iface.read = MappedFile_read;
+        iface.write = MappedFile_write;
+        iface.close = MappedFile_close;
+        result = SDL3_OpenIO(&iface, mapped);
+        if (result) {
+            return result;
+        }
+        SDL3_free(mapped);
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+#else
+    munmap((void *)base, size);
+#endif
+    return NULL;
+}
+#endif /* SDL2COMPAT_HAVE_MMAP */
+
+/* Opt-in SDL_RWops statistics, see SDL2COMPAT_RWOPS_STATS_FILE in README.md. The SDL3 stream behind each RWops
+   is wrapped, so this also sees what SDL3 reads itself in functions like SDL_LoadBMP_RW(). */
+#define SDL2_IO_STATS_READ_BUCKETS 8  /* reads of up to 16, 64, 256, ... 64k bytes, and bigger ones. */
+
+typedef struct SDL2_IOStats
+{
+    SDL_IOStream *io;
+    struct SDL2_IOStats *prev;
+    struct SDL2_IOStats *next;
+    int id;
+    const char *kind;
+    char *name;
+    Uint64 reads;
+    Uint64 read_bytes;
+    Uint64 writes;
+    Uint64 write_bytes;
+    Uint64 seeks;
+    Uint64 ns;  /* spent in reads, writes and seeks. */
+    Uint64 read_sizes[SDL2_IO_STATS_READ_BUCKETS];
+} SDL2_IOStats;
+
+static int WantIOStats = -1;  /* -1 until the hint is checked. */
+static SDL_IOStream *IOStatsFile = NULL;
+static bool IOStatsFileStarted = false;  /* append after the first SDL_Quit(), instead of starting over. */
+static SDL2_IOStats *IOStatsList = NULL;  /* every stream that's still open. */
+static int IOStatsNextId = 0;
+static SDL_SpinLock IOStatsLockCreation = 0;
+static SDL_Mutex *IOStatsLock = NULL;  /* a mutex, since rows are written with it held. Never freed, since streams
+                                          can be closed after SDL_Quit(). */
+
+static void LockIOStats(void)
+{
+    SDL3_LockSpinlock(&IOStatsLockCreation);
+    if (!IOStatsLock) {
+        IOStatsLock = SDL3_CreateMutex();  /* if this fails, there's nothing to do but go on without it. */
+    }
+    SDL3_UnlockSpinlock(&IOStatsLockCreation);
+    SDL3_LockMutex(IOStatsLock);
+}
+
+static void UnlockIOStats(void)
+{
+    SDL3_UnlockMutex(IOStatsLock);
+}
+
+static bool CheckIOStats(void)
+{
+    if (WantIOStats < 0) {
+        const char *hint = SDL3_GetHint("SDL2COMPAT_RWOPS_STATS_FILE");
+        WantIOStats = (hint && *hint) ? 1 : 0;
+    }
+    return WantIOStats > 0;
+}
+
+/* call with LockIOStats() held. */
+static void WriteIOStatsRow(const SDL2_IOStats *stats, bool closed)
+{
+    char row[1024];
+    size_t len;
+    int i;
+
+    if (!IOStatsFile) {
+        const char *path = SDL3_GetHint("SDL2COMPAT_RWOPS_STATS_FILE");
+        IOStatsFile = SDL3_IOFromFile(path, IOStatsFileStarted ? "a" : "w");
+        if (!IOStatsFile) {
+            SDL3_Log("sdl2-compat: couldn't open RWops stats file '%s': %s", path, SDL3_GetError());
+            WantIOStats = 0;
+            return;
+        }
+        if (!IOStatsFileStarted) {
+            static const char header[] = "stream,kind,name,closed,reads,read_bytes,writes,write_bytes,seeks,io_us,"
+                                         "reads_16,reads_64,reads_256,reads_1k,reads_4k,reads_16k,reads_64k,reads_larger\n";
+            SDL3_WriteIO(IOStatsFile, header, sizeof(header) - 1);
+            IOStatsFileStarted = true;
+        }
+    }
+
+    /* quote the name, it's a path and could have commas in it. */
+    len = (size_t)SDL3_snprintf(row, sizeof(row), "%d,%s,\"", stats->id, stats->kind);
+    for (i = 0; stats->name && stats->name[i] && len < sizeof(row) / 2; i++) {
+        if (stats->name[i] == '"') {
+            row[len++] = '"';
+        }
+        row[len++] = stats->name[i];
+    }
+    len += (size_t)SDL3_snprintf(row + len, sizeof(row) - len, "\",%d,%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64,
+                                 closed ? 1 : 0, stats->reads, stats->read_bytes, stats->writes, stats->write_bytes, stats->seeks, stats->ns / SDL_NS_PER_US);
+    for (i = 0; i < SDL2_IO_STATS_READ_BUCKETS; i++) {
+        len += (size_t)SDL3_snprintf(row + len, sizeof(row) - len, ",%" SDL_PRIu64, stats->read_sizes[i]);
+    }
+    len += (size_t)SDL3_snprintf(row + len, sizeof(row) - len, "\n");
+    SDL3_WriteIO(IOStatsFile, row, SDL_min(len, sizeof(row) - 1));
+}
+
+static Sint64 SDLCALL
+IOStats_size(void *userdata)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    return SDL3_GetIOSize(stats->io);
+}
+
+static Sint64 SDLCALL
+IOStats_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    const Uint64 start = SDL3_GetTicksNS();
+    const Sint64 result = SDL3_SeekIO(stats->io, offset, whence);
+
+    stats->ns += SDL3_GetTicksNS() - start;
+    stats->seeks++;
+    return result;
+}
+
+static size_t SDLCALL
+IOStats_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    const Uint64 start = SDL3_GetTicksNS();
+    const size_t result = SDL3_ReadIO(stats->io, ptr, size);
+    int bucket = 0;
+
+    stats->ns += SDL3_GetTicksNS() - start;
+    stats->reads++;
+    stats->read_bytes += result;
+    while (bucket < SDL2_IO_STATS_READ_BUCKETS - 1 && size > ((size_t)16 << (bucket * 2))) {
+        bucket++;
+    }
+    stats->read_sizes[bucket]++;
+
+    if (result < size) {
+        *status = SDL3_GetIOStatus(stats->io);
+    }
+    return result;
+}
+
+static size_t SDLCALL
+IOStats_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    const Uint64 start = SDL3_GetTicksNS();
+    const size_t result = SDL3_WriteIO(stats->io, ptr, size);
+
+    stats->ns += SDL3_GetTicksNS() - start;
+    stats->writes++;
+    stats->write_bytes += result;
+    if (result < size) {
+        *status = SDL3_GetIOStatus(stats->io);
+    }
+    return result;
+}
+
+static bool SDLCALL
+IOStats_flush(void *userdata, SDL_IOStatus *status)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    if (!SDL3_FlushIO(stats->io)) {
+        *status = SDL3_GetIOStatus(stats->io);
+        return false;
+    }
+    return true;
+}
+
+static bool SDLCALL
+IOStats_close(void *userdata)
+{
+    SDL2_IOStats *stats = (SDL2_IOStats *)userdata;
+    bool result;
+
+    LockIOStats();
+    if (WantIOStats > 0) {
+        WriteIOStatsRow(stats, true);
+    }
+    if (stats->prev) {
+        stats->prev->next = stats->next;
+    } else {
+        IOStatsList = stats->next;
+    }
+    if (stats->next) {
+        stats->next->prev = stats->prev;
+    }
+    UnlockIOStats();
+
+    result = SDL3_CloseIO(stats->io);
+    SDL3_free(stats->name);
+    SDL3_free(stats);
+    return result;
+}
+
+/* Returns io, wrapped if RWops statistics are enabled. */
+static SDL_IOStream *
+TrackIOStats(SDL_IOStream *io, const char *kind, const char *name)
+{
+    SDL2_IOStats *stats;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *result;
+
+    if (!io || !CheckIOStats()) {
+        return io;
+    }
+
+    stats = (SDL2_IOStats *)SDL3_calloc(1, sizeof(*stats));
+    if (!stats) {
+        return io;
+    }
+    stats->io = io;
+    stats->kind = kind;
+    stats->name = name ? SDL3_strdup(name) : NULL;
+
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = IOStats_size;
+    iface.seek = IOStats_seek;
+    iface.read = IOStats_read;
+    iface.write = IOStats_write;
+    iface.flush = IOStats_flush;
+    iface.close = IOStats_close;
+    result = SDL3_OpenIO(&iface, stats);
+    if (!result) {
+        SDL3_free(stats->name);
+        SDL3_free(stats);
+        return io;
+    }
+    /* so SDL_RWFromFile() still finds the stdio FILE, etc. */
+    SDL3_CopyProperties(SDL3_GetIOProperties(io), SDL3_GetIOProperties(result));
+
+    LockIOStats();
+    stats->id = IOStatsNextId++;
+    stats->next = IOStatsList;
+    if (IOStatsList) {
+        IOStatsList->prev = stats;
+    }
+    IOStatsList = stats;
+    UnlockIOStats();
+
+    return result;
+}
+
+/* At SDL_Quit(), streams that are still open get a row, too. */
+static void ReportIOStats(void)
+{
+    SDL2_IOStats *stats;
+
+    if (WantIOStats <= 0) {
+        return;  /* never enabled, or the file couldn't be opened. */
+    }
+
+    LockIOStats();
+    if (WantIOStats > 0) {
+        for (stats = IOStatsList; stats; stats = stats->next) {
+            WriteIOStatsRow(stats, false);
+        }
+    }
+    if (IOStatsFile) {
+        SDL3_CloseIO(IOStatsFile);
+        IOStatsFile = NULL;
+    }
+    UnlockIOStats();
+}
+
+static SDL2_RWops *
+OpenFileRW(const char *file, const char *mode)
+{
+    /* only plain read-only opens, "r+" needs a real file. */
+    const bool readonly = file && mode && (SDL3_strcmp(mode, "r") == 0 || SDL3_strcmp(mode, "rb") == 0);
+    SDL_IOStream *io = NULL;
+    Uint32 type = SDL_RWOPS_PLATFORM_FILE;
+
+#ifdef SDL2COMPAT_HAVE_MMAP
+    if (readonly && SDL3_GetHintBoolean("SDL2COMPAT_RWFROMFILE_MMAP", false)) {
+        io = OpenMappedFileIO(file);
+        if (io) {
+            type = SDL_RWOPS_MEMORY_RO;
+        }
+    }
+#endif
+    if (!io && readonly && SDL3_GetHintBoolean("SDL2COMPAT_RWFROMFILE_PREFETCH", false)) {
+        io = OpenPrefetchIO(file);
+    }
+    if (!io) {
+        io = OpenFileIO(file, mode);
+    }
+    return RWops3to2(TrackIOStats(io, "file", file), type);
+}
+
+SDL_DECLSPEC SDL2_RWops *SDLCALL
+SDL_RWFromFile(const char *file, const char *mode)
+{
+    SDL2_RWops *rwops2 = NULL;
+
+    /* match some SDL2 Apple-specific quirks that were removed from SDL3. */
+    #if defined(SDL_PLATFORM_APPLE)
+    char *adjusted_path = NULL;
+    /* If the file mode is writable, skip all the bundle stuff because generally the bundle is read-only. */
+    if (mode && (SDL3_strchr(mode, 'r') != NULL) && SDL3_GetHintBoolean(SDL_HINT_APPLE_RWFROMFILE_USE_RESOURCES, true)) {
+        const char *base = SDL3_GetBasePath();
+        if (base) {
+            if (SDL3_asprintf(&adjusted_path, "%s%s", base, file) < 0) {
+                return NULL;
+            }
+            rwops2 = OpenFileRW(adjusted_path, mode);
+            SDL3_free(adjusted_path);
+        }
+    }
+    if (!rwops2) {
+        rwops2 = OpenFileRW(file, mode);
+    }
+    #else
+    rwops2 = OpenFileRW(file, mode);
+    #endif
+
+    if (rwops2) {
+        const SDL_PropertiesID props = SDL3_GetIOProperties(rwops2->hidden.sdl3.iostrm);
+        if (props) {
+            void *handle = NULL;
+            #if defined(SDL_PLATFORM_WINDOWS)
+            if (!handle) {
+                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_WINDOWS_HANDLE_POINTER, NULL);
+                if (handle) {
+                    rwops2->hidden.windowsio.h = handle;
+                }
+            }
+            #elif defined(SDL_PLATFORM_ANDROID)
+            if (!handle) {
+                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_ANDROID_AASSET_POINTER, NULL);
+                if (handle) {
+                    rwops2->hidden.androidio.asset = handle;
+                }
+            }
+            #endif
+
+            if (!handle) {
+                handle = SDL3_GetPointerProperty(props, SDL_PROP_IOSTREAM_STDIO_FILE_POINTER, NULL);
+                if (handle) {
+                    rwops2->hidden.stdio.autoclose = SDL2_FALSE;
+                    rwops2->hidden.stdio.fp = handle;
+                }
+            }
+        }
+    }
+    return rwops2;
+}
+
+SDL_DECLSPEC SDL2_RWops *SDLCALL
+SDL_RWFromMem(void *mem, int size)
+{
+    if (size <= 0) {
+        SDL3_InvalidParamError("size");
+        return NULL;
+    }
+    return RWops3to2(TrackIOStats(SDL3_IOFromMem(mem, size), "memory", NULL), SDL_RWOPS_MEMORY);
+}
+
+SDL_DECLSPEC SDL2_RWops *SDLCALL
+SDL_RWFromConstMem(const void *mem, int size)
+{
+    if (size <= 0) {
+        SDL3_InvalidParamError("size");
+        return NULL;
+    }
+    return RWops3to2(TrackIOStats(SDL3_IOFromConstMem(mem, size), "const memory", NULL), SDL_RWOPS_MEMORY_RO);
+}
+
+SDL_DECLSPEC Sint64 SDLCALL
+SDL_RWsize(SDL2_RWops *rwops2)
+{
+    return rwops2->size(rwops2);
+}
+
+SDL_DECLSPEC Sint64 SDLCALL
+SDL_RWseek(SDL2_RWops *rwops2, Sint64 offset, int whence)
+{
+    return rwops2->seek(rwops2, offset, whence);
+}
+
+SDL_DECLSPEC Sint64 SDLCALL
+SDL_RWtell(SDL2_RWops *rwops2)
+{
+    return rwops2->seek(rwops2, 0, SDL_IO_SEEK_CUR);
+}
+
+SDL_DECLSPEC size_t SDLCALL
+SDL_RWread(SDL2_RWops *rwops2, void *ptr, size_t size, size_t maxnum)
+{
+    return rwops2->read(rwops2, ptr, size, maxnum);
+}
+
+SDL_DECLSPEC size_t SDLCALL
+SDL_RWwrite(SDL2_RWops *rwops2, const void *ptr, size_t size, size_t num)
+{
+    return rwops2->write(rwops2, ptr, size, num);
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_RWclose(SDL2_RWops *rwops2)
+{
+    if (rwops2->close != RWops3to2_close) {
+        ForgetRWopsBridges(rwops2);  /* the app's close might not use SDL_FreeRW(). */
+    }
+    return rwops2->close(rwops2);
+}
+
+SDL_DECLSPEC Uint8 SDLCALL
+SDL_ReadU8(SDL2_RWops *rwops2)
+{
+    Uint8 x = 0;
+    SDL_RWread(rwops2, &x, sizeof (x), 1);
+    return x;
+}
+
+SDL_DECLSPEC size_t SDLCALL
+SDL_WriteU8(SDL2_RWops *rwops2, Uint8 x)
+{
+    return SDL_RWwrite(rwops2, &x, sizeof(x), 1);
+}
+
+#define DO_RWOPS_ENDIAN(order, bits)        \
+SDL_DECLSPEC Uint##bits SDLCALL             \
+SDL_Read##order##bits(SDL2_RWops *rwops2) { \
+    Uint##bits x = 0;                       \
+    SDL_RWread(rwops2, &x, sizeof (x), 1);  \
+    return SDL_Swap##bits##order(x);        \
+} \
+                                                           \
+SDL_DECLSPEC size_t SDLCALL                                \
+SDL_Write##order##bits(SDL2_RWops *rwops2, Uint##bits x) { \
+    x = SDL_Swap##bits##order(x);                          \
+    return SDL_RWwrite(rwops2, &x, sizeof(x), 1);          \
+}
+DO_RWOPS_ENDIAN(LE, 16)
+DO_RWOPS_ENDIAN(BE, 16)
+DO_RWOPS_ENDIAN(LE, 32)
+DO_RWOPS_ENDIAN(BE, 32)
+DO_RWOPS_ENDIAN(LE, 64)
+DO_RWOPS_ENDIAN(BE, 64)
+#undef DO_RWOPS_ENDIAN
+
+/* stdio SDL_RWops was removed from SDL3, to prevent incompatible C runtime issues */
+#ifndef HAVE_STDIO_H
+SDL_DECLSPEC SDL2_RWops * SDLCALL
+SDL_RWFromFP(void *fp, SDL2_bool autoclose)
+{
+    SDL3_SetError("SDL not compiled with stdio support");
+    return NULL;
+}
+#else
+
+/* !!! FIXME: SDL2 has a bunch of macro salsa to try and use the most 64-bit
+fseek, etc, and I'm avoiding that for now; this can change if it becomes a
+problem.  --ryan. */
+
+/* Functions to read/write stdio file pointers */
+
+static Sint64 SDLCALL
+stdio_size(SDL2_RWops *rwops2)
+{
+    Sint64 pos, size;
+
+    pos = SDL_RWseek(rwops2, 0, SDL_IO_SEEK_CUR);
+    if (pos < 0) {
+        return -1;
+    }
+    size = SDL_RWseek(rwops2, 0, SDL_IO_SEEK_END);
+
+    SDL_RWseek(rwops2, pos, SDL_IO_SEEK_SET);
+    return size;
+}
+
+static Sint64 SDLCALL
+stdio_seek(SDL2_RWops *rwops2, Sint64 offset, int whence)
+{
+    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
+    int stdiowhence;
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        stdiowhence = SEEK_SET;
+        break;
+    case SDL_IO_SEEK_CUR:
+        stdiowhence = SEEK_CUR;
+        break;
+    case SDL_IO_SEEK_END:
+        stdiowhence = SEEK_END;
+        break;
+    default:
+        SDL3_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+
+#if defined(FSEEK_OFF_MIN) && defined(FSEEK_OFF_MAX)
+    if (offset < (Sint64)(FSEEK_OFF_MIN) || offset > (Sint64)(FSEEK_OFF_MAX)) {
+        SDL3_SetError("Seek offset out of range");
+        return -1;
+    }
+#endif
+
+    if (fseek(fp, (long)offset, stdiowhence) == 0) {
+        Sint64 pos = ftell(fp);
+        if (pos < 0) {
+            SDL3_SetError("Couldn't get stream offset");
+            return -1;
+        }
+        return pos;
+    }
+    return SDL_Error(SDL_EFSEEK);
+}
+
+static size_t SDLCALL
+stdio_read(SDL2_RWops *rwops2, void *ptr, size_t size, size_t maxnum)
+{
+    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
+    size_t nread = fread(ptr, size, maxnum, fp);
+    if (nread == 0 && ferror(fp)) {
+        SDL_Error(SDL_EFREAD);
+    }
+    return nread;
+}
+
+static size_t SDLCALL
+stdio_write(SDL2_RWops *rwops2, const void *ptr, size_t size, size_t num)
+{
+    FILE *fp = (FILE *) rwops2->hidden.stdio.fp;
+    size_t nwrote = fwrite(ptr, size, num, fp);
+    if (nwrote == 0 && ferror(fp)) {
+        SDL_Error(SDL_EFWRITE);
+    }
+    return nwrote;
+}
+
+static int SDLCALL
+stdio_close(SDL2_RWops *rwops2)
+{
+    int status = 0;
+    if (rwops2) {
+        if (rwops2->hidden.stdio.autoclose) {
+            if (fclose((FILE *)rwops2->hidden.stdio.fp) != 0) {
+                status = SDL_Error(SDL_EFWRITE);
             }
         }
         SDL_FreeRW(rwops2);
@@ -3834,6 +4810,50 @@ stdio_close(SDL2_RWops *rwops2)
     return status;
 }
 
+static Sint64 SDLCALL
+OwnedRWops_size(void *userdata)
+{
+    return SDL_RWsize((SDL2_RWops *)userdata);
+}
+
+static Sint64 SDLCALL
+OwnedRWops_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    return SDL_RWseek((SDL2_RWops *)userdata, offset, whence);
+}
+
+static size_t SDLCALL
+OwnedRWops_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    return SDL_RWread((SDL2_RWops *)userdata, ptr, 1, size);
+}
+
+static size_t SDLCALL
+OwnedRWops_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    return SDL_RWwrite((SDL2_RWops *)userdata, ptr, 1, size);
+}
+
+static bool SDLCALL
+OwnedRWops_close(void *userdata)
+{
+    return SDL_RWclose((SDL2_RWops *)userdata) == 0;
+}
+
+/* Unlike RWops2to3(), the SDL3 stream owns rwops2 and closes it. */
+static SDL_IOStream *
+OpenOwnedRWopsIO(SDL2_RWops *rwops2)
+{
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = OwnedRWops_size;
+    iface.seek = OwnedRWops_seek;
+    iface.read = OwnedRWops_read;
+    iface.write = OwnedRWops_write;
+    iface.close = OwnedRWops_close;
+    return SDL3_OpenIO(&iface, rwops2);
+}
+
 SDL_DECLSPEC SDL2_RWops * SDLCALL
 SDL_RWFromFP(void *fp, SDL2_bool autoclose)
 {
@@ -3847,33 +4867,179 @@ SDL_RWFromFP(void *fp, SDL2_bool autoclose)
         rwops->hidden.stdio.fp = (FILE *) fp;
         rwops->hidden.stdio.autoclose = autoclose;
         rwops->type = SDL_RWOPS_STDFILE;
+
+        if (CheckIOStats()) {
+            /* count it like the other RWops, through an SDL3 stream that owns this one. */
+            SDL_IOStream *io = OpenOwnedRWopsIO(rwops);
+            if (io) {
+                rwops = RWops3to2(TrackIOStats(io, "stdio", NULL), SDL_RWOPS_STDFILE);
+                if (rwops) {
+                    rwops->hidden.stdio.fp = (FILE *) fp;
+                    rwops->hidden.stdio.autoclose = autoclose;
+                }
+            }
+        }
     }
     return rwops;
 }
 #endif
 
+/* SDL3 reads and writes through app RWops a few bytes at a time, so the bridge buffers them. Reads only read
+   ahead once the app RWops has seeked backwards, so the unread part can be given back when the bridge closes.
+   See SDL2COMPAT_RWOPS_BUFFERING in README.md. */
+#define SDL2_RWOPS_BRIDGE_BUFFER_SIZE 4096
+
+typedef struct SDL2_RWopsBridge
+{
+    SDL2_RWops *rwops2;
+    Uint8 *buffer;  /* NULL if buffering is disabled. */
+    size_t len;     /* bytes read ahead, or bytes waiting to be written. */
+    size_t pos;     /* next unread byte, when reading. */
+    bool writing;
+    int seekable;   /* -1 until the first read that wants to read ahead tries seeking back. */
+} SDL2_RWopsBridge;
+
+/* Writes out pending bytes, or seeks the app RWops back over unread ones. */
+static bool FlushRWopsBridge(SDL2_RWopsBridge *bridge)
+{
+    bool result = true;
+    if (bridge->writing) {
+        if (bridge->len > 0 && SDL_RWwrite(bridge->rwops2, bridge->buffer, 1, bridge->len) != bridge->len) {
+            result = false;
+        }
+    } else if (bridge->pos < bridge->len) {
+        if (SDL_RWseek(bridge->rwops2, -(Sint64)(bridge->len - bridge->pos), SDL_IO_SEEK_CUR) < 0) {
+            result = false;
+        }
+    }
+    bridge->len = bridge->pos = 0;
+    bridge->writing = false;
+    return result;
+}
+
 static Sint64 SDLCALL
 RWops2to3_size(void *userdata)
 {
-    return SDL_RWsize((SDL2_RWops *) userdata);
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+    if (bridge->writing && !FlushRWopsBridge(bridge)) {
+        return -1;
+    }
+    return SDL_RWsize(bridge->rwops2);
 }
 
 static Sint64 SDLCALL
 RWops2to3_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
 {
-    return SDL_RWseek((SDL2_RWops *) userdata, offset, whence);
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+
+    /* SDL_TellIO() and short skips stay in the read-ahead buffer. */
+    if (whence == SDL_IO_SEEK_CUR && !bridge->writing && bridge->len > 0 &&
+        offset >= -(Sint64)bridge->pos && offset <= (Sint64)(bridge->len - bridge->pos)) {
+        const Sint64 end = SDL_RWtell(bridge->rwops2);
+        if (end < 0) {
+            return -1;
+        }
+        bridge->pos = (size_t)((Sint64)bridge->pos + offset);
+        return end - (Sint64)(bridge->len - bridge->pos);
+    }
+
+    if (!FlushRWopsBridge(bridge)) {
+        return -1;
+    }
+    return SDL_RWseek(bridge->rwops2, offset, whence);
 }
 
 static size_t SDLCALL
 RWops2to3_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
 {
-    return SDL_RWread((SDL2_RWops *) userdata, ptr, 1, size);
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    if (!bridge->buffer) {
+        return SDL_RWread(bridge->rwops2, ptr, 1, size);
+    }
+    if (bridge->writing && !FlushRWopsBridge(bridge)) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    while (size > 0) {
+        size_t amount = bridge->len - bridge->pos;
+        if (amount > 0) {
+            if (amount > size) {
+                amount = size;
+            }
+            SDL3_memcpy(dst, bridge->buffer + bridge->pos, amount);
+            bridge->pos += amount;
+            dst += amount;
+            size -= amount;
+            total += amount;
+            continue;
+        }
+
+        if (bridge->seekable < 0 && size < SDL2_RWOPS_BRIDGE_BUFFER_SIZE) {
+            /* Some app RWops report a position but can't go back, so find out by doing it: read this request
+               directly, and seek back over it. If that fails, keep what was read and don't read ahead. */
+            amount = SDL_RWread(bridge->rwops2, dst, 1, size);
+            if (amount == 0) {
+                break;
+            }
+            if (SDL_RWseek(bridge->rwops2, -(Sint64)amount, SDL_IO_SEEK_CUR) < 0) {
+                bridge->seekable = 0;
+                dst += amount;
+                size -= amount;
+                total += amount;
+                continue;
+            }
+            bridge->seekable = 1;
+        }
+        if (size >= SDL2_RWOPS_BRIDGE_BUFFER_SIZE || !bridge->seekable) {
+            total += SDL_RWread(bridge->rwops2, dst, 1, size);
+            break;
+        }
+        bridge->pos = 0;
+        bridge->len = SDL_RWread(bridge->rwops2, bridge->buffer, 1, SDL2_RWOPS_BRIDGE_BUFFER_SIZE);
+        if (bridge->len == 0) {
+            break;
+        }
+    }
+    return total;
 }
 
 static size_t SDLCALL
 RWops2to3_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
-    return SDL_RWwrite((SDL2_RWops *) userdata, ptr, 1, size);
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+
+    if (!bridge->buffer) {
+        return SDL_RWwrite(bridge->rwops2, ptr, 1, size);
+    }
+
+    if (!bridge->writing || bridge->len + size > SDL2_RWOPS_BRIDGE_BUFFER_SIZE) {
+        if (!FlushRWopsBridge(bridge)) {
+            *status = SDL_IO_STATUS_ERROR;
+            return 0;
+        }
+        bridge->writing = true;
+    }
+    if (size >= SDL2_RWOPS_BRIDGE_BUFFER_SIZE) {
+        return SDL_RWwrite(bridge->rwops2, ptr, 1, size);
+    }
+    SDL3_memcpy(bridge->buffer + bridge->len, ptr, size);
+    bridge->len += size;
+    return size;
+}
+
+static bool SDLCALL
+RWops2to3_flush(void *userdata, SDL_IOStatus *status)
+{
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+    if (bridge->writing && !FlushRWopsBridge(bridge)) {
+        *status = SDL_IO_STATUS_ERROR;
+        return false;
+    }
+    return true;
 }
 
 static bool SDLCALL
@@ -3881,111 +5047,523 @@ RWops2to3_close(void *userdata)
 {
     /* Never close the SDL2_RWops here! This is just a wrapper to talk to SDL3 APIs. We will manually close the rwops2 if appropriate. */
     /*return SDL3_CloseIO((SDL2_RWops *) userdata) ? 0 : -1;*/
-    return true;
+    SDL2_RWopsBridge *bridge = (SDL2_RWopsBridge *)userdata;
+    const bool result = FlushRWopsBridge(bridge);
+    SDL3_free(bridge);
+    return result;
+}
+
+static Sint64 SDLCALL
+RWops2to3_size_broken(void *userdata)
+{
+    return -1;
 }
 
 static SDL_IOStream *
-RWops2to3(SDL2_RWops *rwops2)
+OpenRWopsBridge(SDL2_RWops *rwops2, bool broken_size, SDL2_RWopsBridge **result)
 {
     SDL_IOStream *iostrm3 = NULL;
     if (rwops2) {
+        const bool buffered = SDL3_GetHintBoolean("SDL2COMPAT_RWOPS_BUFFERING", true);
+        SDL2_RWopsBridge *bridge;
         SDL_IOStreamInterface iface;
+
+        /* the buffer lives right after the bridge. */
+        bridge = (SDL2_RWopsBridge *)SDL3_malloc(sizeof(*bridge) + (buffered ? SDL2_RWOPS_BRIDGE_BUFFER_SIZE : 0));
+        if (!bridge) {
+            return NULL;
+        }
+        SDL3_zerop(bridge);
+        bridge->rwops2 = rwops2;
+        bridge->buffer = buffered ? (Uint8 *)(bridge + 1) : NULL;
+        bridge->seekable = -1;
+
         SDL_INIT_INTERFACE(&iface);
-        iface.size = RWops2to3_size;
+        iface.size = broken_size ? RWops2to3_size_broken : RWops2to3_size;
         iface.seek = RWops2to3_seek;
         iface.read = RWops2to3_read;
         iface.write = RWops2to3_write;
+        iface.flush = RWops2to3_flush;
         iface.close = RWops2to3_close;
 
-        iostrm3 = SDL3_OpenIO(&iface, rwops2);
+        iostrm3 = SDL3_OpenIO(&iface, bridge);
         if (!iostrm3) {
+            SDL3_free(bridge);
             return NULL;
         }
+        *result = bridge;
     }
     return iostrm3;
 }
 
-static Sint64 SDLCALL
-RWops2to3_size_broken(void *userdata)
+/* Apps that load many things from one RWops would otherwise get a new bridge for every call, so the last few
+   are kept. A bridge is only in one call at a time, and it's flushed when the call is done, so the app can use
+   its RWops in between. Bridges never look at their RWops outside of a call, so an app that frees its RWops
+   without SDL_FreeRW() only leaves an entry behind until it's reused. */
+typedef struct SDL2_RWopsBridgeCacheEntry
 {
-    return -1;
-}
+    SDL2_RWops *rwops2;  /* NULL if the entry is free, or its RWops was freed while in use. */
+    SDL_IOStream *iostrm3;
+    SDL2_RWopsBridge *bridge;
+    bool broken_size;
+    bool in_use;
+} SDL2_RWopsBridgeCacheEntry;
+
+static SDL2_RWopsBridgeCacheEntry RWopsBridgeCache[8];
+static int RWopsBridgeCacheNext = 0;
+static SDL_SpinLock RWopsBridgeCacheLock = 0;
 
+/* RWops made by RWops3to2() hand back their SDL3 stream, instead of SDL3 reading through both wrappers.
+   Anything else gets a bridge. Either way, the result must be given back with RWops2to3_Release(), and not
+   closed by SDL3. */
 static SDL_IOStream *
-RWops2to3_BrokenSize(SDL2_RWops *rwops2)
+RWops2to3_Acquire(SDL2_RWops *rwops2, bool broken_size)
 {
-    SDL_IOStream *iostrm3 = NULL;
-    if (rwops2) {
-        SDL_IOStreamInterface iface;
-        SDL_INIT_INTERFACE(&iface);
-        iface.size = RWops2to3_size_broken;
-        iface.seek = RWops2to3_seek;
-        iface.read = RWops2to3_read;
-        iface.write = RWops2to3_write;
-        iface.close = RWops2to3_close;
+    SDL2_RWopsBridgeCacheEntry *entry = NULL;
+    SDL2_RWopsBridge *bridge = NULL;
+    SDL_IOStream *evicted = NULL;
+    SDL_IOStream *iostrm3;
+    int i;
+
+    if (!rwops2) {
+        return NULL;
+    } else if (rwops2->close == RWops3to2_close && rwops2->hidden.sdl3.iostrm) {
+        return rwops2->hidden.sdl3.iostrm;
+    }
+
+    SDL3_LockSpinlock(&RWopsBridgeCacheLock);
+    for (i = 0; i < (int)SDL_arraysize(RWopsBridgeCache); i++) {
+        entry = &RWopsBridgeCache[i];
+        if (entry->rwops2 == rwops2 && entry->broken_size == broken_size && !entry->in_use) {
+            entry->in_use = true;
+            SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+            return entry->iostrm3;
+        }
+    }
+    SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+
+    iostrm3 = OpenRWopsBridge(rwops2, broken_size, &bridge);
+    if (!iostrm3) {
+        return NULL;
+    }
+
+    /* take the next slot that isn't in a call; if they all are, this bridge is closed on release. */
+    SDL3_LockSpinlock(&RWopsBridgeCacheLock);
+    for (i = 0; i < (int)SDL_arraysize(RWopsBridgeCache); i++) {
+        entry = &RWopsBridgeCache[RWopsBridgeCacheNext];
+        RWopsBridgeCacheNext = (RWopsBridgeCacheNext + 1) % (int)SDL_arraysize(RWopsBridgeCache);
+        if (!entry->in_use) {
+            evicted = entry->iostrm3;
+            entry->rwops2 = rwops2;
+            entry->iostrm3 = iostrm3;
+            entry->bridge = bridge;
+            entry->broken_size = broken_size;
+            entry->in_use = true;
+            break;
+        }
+    }
+    SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+
+    if (evicted) {
+        SDL3_CloseIO(evicted);
+    }
+    return iostrm3;
+}
+
+/* Returns false, with the error set, if pending bytes couldn't be written out or unread ones given back; the
+   caller must then fail too, since the app's RWops isn't where the call left it. */
+static bool
+RWops2to3_Release(SDL2_RWops *rwops2, SDL_IOStream *iostrm3)
+{
+    bool result;
+    int i;
+
+    if (!iostrm3 || (rwops2->close == RWops3to2_close && iostrm3 == rwops2->hidden.sdl3.iostrm)) {
+        return true;
+    }
+
+    SDL3_LockSpinlock(&RWopsBridgeCacheLock);
+    for (i = 0; i < (int)SDL_arraysize(RWopsBridgeCache); i++) {
+        SDL2_RWopsBridgeCacheEntry *entry = &RWopsBridgeCache[i];
+        if (entry->iostrm3 == iostrm3) {
+            if (entry->rwops2) {
+                /* the bridge is still locked by in_use, so it's safe to flush it outside the spinlock. */
+                SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+                result = FlushRWopsBridge(entry->bridge);
+                entry->bridge->seekable = -1;  /* the app might free this RWops and make a different one at its address. */
+                SDL3_LockSpinlock(&RWopsBridgeCacheLock);
+                entry->in_use = false;
+                SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+                if (!result) {
+                    SDL3_SetError("Couldn't flush buffered data to the RWops");
+                }
+                return result;
+            }
+            SDL3_zerop(entry);  /* its RWops was freed during the call. */
+            break;
+        }
+    }
+    SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+
+    result = SDL3_CloseIO(iostrm3);  /* flushes the bridge, too. */
+    if (!result) {
+        SDL3_SetError("Couldn't flush buffered data to the RWops");
+    }
+    return result;
+}
+
+/* Called when an app RWops goes away, so a new RWops at the same address starts over. */
+static void ForgetRWopsBridges(SDL2_RWops *rwops2)
+{
+    SDL_IOStream *closing[SDL_arraysize(RWopsBridgeCache)];
+    int num_closing = 0;
+    int i;
+
+    SDL3_LockSpinlock(&RWopsBridgeCacheLock);
+    for (i = 0; i < (int)SDL_arraysize(RWopsBridgeCache); i++) {
+        SDL2_RWopsBridgeCacheEntry *entry = &RWopsBridgeCache[i];
+        if (entry->rwops2 == rwops2) {
+            if (entry->in_use) {
+                entry->rwops2 = NULL;  /* RWops2to3_Release() will close it. */
+            } else {
+                closing[num_closing++] = entry->iostrm3;
+                SDL3_zerop(entry);
+            }
+        }
+    }
+    SDL3_UnlockSpinlock(&RWopsBridgeCacheLock);
+
+    for (i = 0; i < num_closing; i++) {
+        SDL3_CloseIO(closing[i]);
+    }
+}
+
+static void FreeRWopsBridgeCache(void)
+{
+    int i;
+    for (i = 0; i < (int)SDL_arraysize(RWopsBridgeCache); i++) {
+        SDL2_RWopsBridgeCacheEntry *entry = &RWopsBridgeCache[i];
+        if (entry->iostrm3 && !entry->in_use) {
+            SDL3_CloseIO(entry->iostrm3);
+            SDL3_zerop(entry);
+        }
+    }
+}
+
+/* SDL_LoadFile_RW() for app RWops. Reading straight into the result, in as few calls as possible, beats going
+   through the bridge: if the size is known, it's one allocation and one read plus the one that finds EOF. */
+static void *
+LoadRWopsData(SDL2_RWops *rwops2, size_t *datasize)
+{
+    const Sint64 size = SDL_RWsize(rwops2);
+    const Sint64 pos = (size > 0) ? SDL_RWtell(rwops2) : -1;
+    size_t capacity = 4096;  /* for streams that don't know their size, this doubles as needed. */
+    size_t total = 0;
+    Uint8 *data;
+
+    if (size > 0 && pos >= 0 && pos < size && (Uint64)(size - pos) < SDL_SIZE_MAX - 1) {
+        capacity = (size_t)(size - pos) + 1;  /* +1 so a correct size finds EOF without growing. */
+    }
+
+    data = (Uint8 *)SDL3_malloc(capacity + 1);
+    if (!data) {
+        return NULL;
+    }
+
+    for (;;) {
+        size_t amount;
+        if (total == capacity) {
+            const size_t new_capacity = (capacity < SDL_SIZE_MAX / 2) ? capacity * 2 : SDL_SIZE_MAX - 1;
+            Uint8 *ptr = (new_capacity > capacity) ? (Uint8 *)SDL3_realloc(data, new_capacity + 1) : NULL;
+            if (!ptr) {
+                SDL3_free(data);
+                return NULL;
+            }
+            data = ptr;
+            capacity = new_capacity;
+        }
+        amount = SDL_RWread(rwops2, data + total, 1, capacity - total);
+        if (amount == 0) {
+            break;
+        }
+        total += amount;
+    }
+
+    /* give back what a wrong size, or the last doubling, didn't need. */
+    if (capacity - total > 4096) {
+        Uint8 *ptr = (Uint8 *)SDL3_realloc(data, total + 1);
+        if (ptr) {
+            data = ptr;
+        }
+    }
+
+    data[total] = '\0';
+    if (datasize) {
+        *datasize = total;
+    }
+    return data;
+}
+
+SDL_DECLSPEC void *SDLCALL
+SDL_LoadFile_RW(SDL2_RWops *rwops2, size_t *datasize, int freesrc)
+{
+    void *retval = NULL;
+
+    if (rwops2 && rwops2->close != RWops3to2_close) {
+        retval = LoadRWopsData(rwops2, datasize);
+    } else {
+        SDL_IOStream *iostrm3 = RWops2to3_Acquire(rwops2, false);
+        if (iostrm3) {
+            retval = SDL3_LoadFile_IO(iostrm3, datasize, false);
+            if (!RWops2to3_Release(rwops2, iostrm3)) {
+                SDL3_free(retval);
+                retval = NULL;
+            }
+        }
+    }
+
+    if (rwops2 && freesrc) {
+        SDL_RWclose(rwops2);
+    }
+
+    return retval;
+}
+
+static Uint16 ReadWAVLE16(const Uint8 *ptr)
+{
+    return (Uint16)(ptr[0] | (ptr[1] << 8));
+}
+
+static Uint32 ReadWAVLE32(const Uint8 *ptr)
+{
+    return (Uint32)ptr[0] | ((Uint32)ptr[1] << 8) | ((Uint32)ptr[2] << 16) | ((Uint32)ptr[3] << 24);
+}
+
+/* Plain 8, 16 and 32-bit integer and 32-bit float WAVs don't need decoding, so the data chunk is read straight
+   into the buffer the app gets, sized from the chunk header. Anything else, or anything odd about the file,
+   returns false with rwops2 back where it started, and SDL3 loads it. This never calls the size function,
+   see SDL_LoadWAV_RW(). */
+static bool
+LoadPlainWAV(SDL2_RWops *rwops2, SDL_AudioSpec *spec3, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    const Sint64 start = SDL_RWtell(rwops2);
+    Uint8 header[12];
+    Uint8 fmt[40];
+    Uint16 block_align = 0;
+    bool have_fmt = false;
+
+    if (start < 0) {
+        return false;  /* we couldn't go back for SDL3. */
+    }
+
+    if (SDL_RWread(rwops2, header, 1, sizeof(header)) != sizeof(header) ||
+        SDL3_memcmp(header, "RIFF", 4) != 0 || SDL3_memcmp(header + 8, "WAVE", 4) != 0) {
+        goto unhandled;
+    }
+
+    for (;;) {
+        Uint32 length;
+
+        if (SDL_RWread(rwops2, header, 1, 8) != 8) {
+            goto unhandled;
+        }
+        length = ReadWAVLE32(header + 4);
+
+        if (SDL3_memcmp(header, "fmt ", 4) == 0) {
+            Uint16 tag, bits;
+            if (have_fmt || length < 16 || length > sizeof(fmt) || SDL_RWread(rwops2, fmt, 1, length) != length) {
+                goto unhandled;
+            }
+            if ((length & 1) && SDL_RWseek(rwops2, 1, SDL_IO_SEEK_CUR) < 0) {
+                goto unhandled;
+            }
+            tag = ReadWAVLE16(fmt);
+            if (tag == 0xFFFE && length >= 26) {  /* WAVE_FORMAT_EXTENSIBLE, the subformat GUID starts with the real tag. */
+                tag = ReadWAVLE16(fmt + 24);
+            }
+            bits = ReadWAVLE16(fmt + 14);
+            if (tag == 1 && bits == 8) {
+                spec3->format = SDL_AUDIO_U8;
+            } else if (tag == 1 && bits == 16) {
+                spec3->format = SDL_AUDIO_S16LE;
+            } else if (tag == 1 && bits == 32) {
+                spec3->format = SDL_AUDIO_S32LE;
+            } else if (tag == 3 && bits == 32) {
+                spec3->format = SDL_AUDIO_F32LE;
+            } else {
+                goto unhandled;
+            }
+            spec3->channels = ReadWAVLE16(fmt + 2);
+            spec3->freq = (int)ReadWAVLE32(fmt + 4);
+            block_align = ReadWAVLE16(fmt + 12);
+            if (spec3->channels == 0 || spec3->freq <= 0 || block_align != spec3->channels * (bits / 8)) {
+                goto unhandled;
+            }
+            have_fmt = true;
+        } else if (SDL3_memcmp(header, "data", 4) == 0) {
+            Uint8 *data;
+            Uint32 total = 0;
+
+            /* 0xFFFFFFFF is what streaming writers leave behind; SDL3 knows how to deal with that. */
+            if (!have_fmt || length == 0 || length == 0xFFFFFFFF) {
+                goto unhandled;
+            }
+            length -= length % block_align;  /* whole sample frames only, like SDL3. */
+
+            data = (Uint8 *)SDL3_malloc(length);
+            if (!data) {
+                goto unhandled;
+            }
+            while (total < length) {
+                const size_t amount = SDL_RWread(rwops2, data + total, 1, length - total);
+                if (amount == 0) {
+                    break;
+                }
+                total += (Uint32)amount;
+            }
+            if (total < length) {
+                SDL3_free(data);  /* truncated, SDL3 decides how much of it to keep. */
+                goto unhandled;
+            }
+            *audio_buf = data;
+            *audio_len = length;
+            return true;
+        } else if (SDL_RWseek(rwops2, (Sint64)length + (length & 1), SDL_IO_SEEK_CUR) < 0) {
+            goto unhandled;
+        }
+    }
+
+unhandled:
+    SDL_RWseek(rwops2, start, SDL_IO_SEEK_SET);
+    return false;
+}
+
+SDL_DECLSPEC SDL2_AudioSpec *SDLCALL
+SDL_LoadWAV_RW(SDL2_RWops *rwops2, int freesrc, SDL2_AudioSpec *spec2, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    SDL2_AudioSpec *retval = NULL;
+
+    if (spec2 == NULL) {
+        SDL3_InvalidParamError("spec");
+    } else {
+        SDL_AudioSpec spec3;
+        bool rc = false;
+
+        if (rwops2 && audio_buf && audio_len) {
+            rc = LoadPlainWAV(rwops2, &spec3, audio_buf, audio_len);
+        }
+        if (!rc) {
+            // SDL2 didn't call the size function, so Hearts of Iron IV and Stellaris both pass in RWops structures that have garbage size pointers.
+            // SDL3 queries the size to prevent out of bounds loading, but can handle streams that don't implement it, so we'll just proactively prevent crashes here.
+            // Our own RWops have a real size, and RWops2to3_Acquire() unwraps those.
+            SDL_IOStream *iostrm3 = RWops2to3_Acquire(rwops2, true);
+            if (iostrm3) {
+                rc = SDL3_LoadWAV_IO(iostrm3, false, &spec3, audio_buf, audio_len);
+                if (!RWops2to3_Release(rwops2, iostrm3) && rc) {
+                    SDL3_free(*audio_buf);
+                    *audio_buf = NULL;
+                    *audio_len = 0;
+                    rc = false;
+                }
+            }
+        }
+
+        SDL3_zerop(spec2);
+        if (rc) {
+            spec2->format = spec3.format;
+            spec2->channels = spec3.channels;
+            spec2->freq = spec3.freq;
+            spec2->samples = 4096; /* This is what SDL2 hardcodes, also. */
+            spec2->silence = SDL3_GetSilenceValueForFormat(spec3.format);
+            retval = spec2;
+        }
+    }
+
+    if (rwops2 && freesrc) {
+        SDL_RWclose(rwops2);
+    }
+
+    return retval;
+}
+
+/* Apps (and SDL_ttf) create and free lots of short-lived surfaces, so keep some freed SDL2_Surface structs around.
+   Pooled surfaces are linked through their userdata field. */
+#define SDL2_MAX_POOLED_SURFACES 64
+
+static SDL2_Surface *SurfacePool = NULL;
+static int NumPooledSurfaces = 0;
+static SDL_SpinLock SurfacePoolLock = 0;
+static int WantSurfacePool = -1;  /* -1 until the hint is checked, again after SDL_Quit. */
+
+static bool UseSurfacePool(void)
+{
+    if (WantSurfacePool < 0) {
+        WantSurfacePool = SDL3_GetHintBoolean("SDL2COMPAT_SURFACE_POOL", true) ? 1 : 0;
+    }
+    return WantSurfacePool > 0;
+}
+
+static SDL2_Surface *AllocSurface2(void)
+{
+    SDL2_Surface *surface;
+
+    SDL3_LockSpinlock(&SurfacePoolLock);
+    surface = SurfacePool;
+    if (surface) {
+        SurfacePool = (SDL2_Surface *)surface->userdata;
+        --NumPooledSurfaces;
+    }
+    SDL3_UnlockSpinlock(&SurfacePoolLock);
 
-        iostrm3 = SDL3_OpenIO(&iface, rwops2);
-        if (!iostrm3) {
-            return NULL;
-        }
+    if (surface) {
+        SDL3_zerop(surface);
+    } else {
+        surface = (SDL2_Surface *)SDL3_calloc(1, sizeof(*surface));
     }
-    return iostrm3;
+    return surface;
 }
 
-SDL_DECLSPEC void *SDLCALL
-SDL_LoadFile_RW(SDL2_RWops *rwops2, size_t *datasize, int freesrc)
+static void ReleaseSurface2(SDL2_Surface *surface)
 {
-    void *retval = NULL;
-
-    SDL_IOStream *iostrm3 = RWops2to3(rwops2);
-    if (iostrm3) {
-        retval = SDL3_LoadFile_IO(iostrm3, datasize, true);  /* always close the iostrm3 bridge object. */
+    if (!UseSurfacePool()) {
+        SDL3_free(surface);
+        return;
     }
 
-    if (rwops2 && freesrc) {
-        SDL_RWclose(rwops2);
+    SDL3_LockSpinlock(&SurfacePoolLock);
+    if (NumPooledSurfaces < SDL2_MAX_POOLED_SURFACES) {
+        surface->userdata = SurfacePool;
+        SurfacePool = surface;
+        ++NumPooledSurfaces;
+        surface = NULL;
     }
+    SDL3_UnlockSpinlock(&SurfacePoolLock);
 
-    return retval;
+    SDL3_free(surface);
 }
 
-SDL_DECLSPEC SDL2_AudioSpec *SDLCALL
-SDL_LoadWAV_RW(SDL2_RWops *rwops2, int freesrc, SDL2_AudioSpec *spec2, Uint8 **audio_buf, Uint32 *audio_len)
+static void FreeSurfacePool(void)
 {
-    SDL2_AudioSpec *retval = NULL;
+    SDL2_Surface *surface;
 
-    if (spec2 == NULL) {
-        SDL3_InvalidParamError("spec");
-    } else {
-        // SDL2 didn't call the size function, so Hearts of Iron IV and Stellaris both pass in RWops structures that have garbage size pointers.
-        // SDL3 queries the size to prevent out of bounds loading, but can handle streams that don't implement it, so we'll just proactively prevent crashes here.
-        SDL_IOStream *iostrm3 = RWops2to3_BrokenSize(rwops2);
-        if (iostrm3) {
-            SDL_AudioSpec spec3;
-            const bool rc = SDL3_LoadWAV_IO(iostrm3, true, &spec3, audio_buf, audio_len);   /* always close the iostrm3 bridge object. */
-            SDL3_zerop(spec2);
-            if (rc) {
-                spec2->format = spec3.format;
-                spec2->channels = spec3.channels;
-                spec2->freq = spec3.freq;
-                spec2->samples = 4096; /* This is what SDL2 hardcodes, also. */
-                spec2->silence = SDL3_GetSilenceValueForFormat(spec3.format);
-                retval = spec2;
-            }
-        }
-    }
+    SDL3_LockSpinlock(&SurfacePoolLock);
+    surface = SurfacePool;
+    SurfacePool = NULL;
+    NumPooledSurfaces = 0;
+    WantSurfacePool = -1;
+    SDL3_UnlockSpinlock(&SurfacePoolLock);
 
-    if (rwops2 && freesrc) {
-        SDL_RWclose(rwops2);
+    while (surface) {
+        SDL2_Surface *next = (SDL2_Surface *)surface->userdata;
+        SDL3_free(surface);
+        surface = next;
     }
-
-    return retval;
 }
 
 static SDL2_Surface *CreateSurface2from3(SDL_Surface *surface3)
 {
     /* Allocate the surface */
-    SDL2_Surface *surface = (SDL2_Surface *)SDL3_calloc(1, sizeof(*surface));
+    SDL2_Surface *surface = AllocSurface2();
     if (!surface) {
         SDL3_OutOfMemory();
         return NULL;
@@ -4039,6 +5617,15 @@ static SDL2_Surface *Surface3to2(SDL_Surface *surface)
     return surface2;
 }
 
+/* For surfaces SDL3 just created, which can't have an SDL2 surface yet, so there's nothing to look up. */
+static SDL2_Surface *NewSurface3to2(SDL_Surface *surface)
+{
+    if (!surface) {
+        return NULL;
+    }
+    return CreateSurface2from3(surface);
+}
+
 static void SynchronizeSurface3to2(SDL_Surface *surface, SDL2_Surface *surface2)
 {
     /* Synchronize any changes made by SDL to the SDL3 surface
@@ -4065,13 +5652,23 @@ static SDL_Surface *Surface2to3(SDL2_Surface *surface)
          * The application might have changed memory allocation, e.g.:
          * https://github.com/libsdl-org/SDL_ttf/blob/7e4a456bf463b887b94c191030dd742d7654d6ff/SDL_ttf.c#L1476-L1478
          */
-        surface3->w = surface->w;
-        surface3->h = surface->h;
-        surface3->flags &= ~SHARED_SURFACE_FLAGS;
-        surface3->flags |= (surface->flags & SHARED_SURFACE_FLAGS);
-        surface3->pixels = surface->pixels;
-        surface3->pitch = surface->pitch;
-        SDL3_SetSurfacePalette(surface3, surface->format->palette);
+        /* The SDL3 surface holds what we last synchronized, so only touch what changed. This is called for
+         * every blit, and setting the palette invalidates SDL3's blit map even when it's the same palette.
+         * Palette color changes are still noticed, through the palette version.
+         */
+        if (surface3->w != surface->w || surface3->h != surface->h ||
+            surface3->pixels != surface->pixels || surface3->pitch != surface->pitch ||
+            (surface3->flags & SHARED_SURFACE_FLAGS) != (surface->flags & SHARED_SURFACE_FLAGS)) {
+            surface3->w = surface->w;
+            surface3->h = surface->h;
+            surface3->flags &= ~SHARED_SURFACE_FLAGS;
+            surface3->flags |= (surface->flags & SHARED_SURFACE_FLAGS);
+            surface3->pixels = surface->pixels;
+            surface3->pitch = surface->pitch;
+        }
+        if (SDL3_GetSurfacePalette(surface3) != surface->format->palette) {
+            SDL3_SetSurfacePalette(surface3, surface->format->palette);
+        }
     }
     return surface3;
 }
@@ -4080,9 +5677,13 @@ SDL_DECLSPEC SDL2_Surface *SDLCALL
 SDL_LoadBMP_RW(SDL2_RWops *rwops2, int freesrc)
 {
     SDL_Surface *retval = NULL;
-    SDL_IOStream *iostrm3 = RWops2to3(rwops2);
+    SDL_IOStream *iostrm3 = RWops2to3_Acquire(rwops2, false);
     if (iostrm3) {
-        retval = SDL3_LoadBMP_IO(iostrm3, true);   /* always close the iostrm3 bridge object. */
+        retval = SDL3_LoadBMP_IO(iostrm3, false);
+        if (!RWops2to3_Release(rwops2, iostrm3)) {
+            SDL3_DestroySurface(retval);
+            retval = NULL;
+        }
     }
     if (rwops2 && freesrc) {
         SDL_RWclose(rwops2);
@@ -4101,9 +5702,12 @@ SDL_DECLSPEC int SDLCALL
 SDL_SaveBMP_RW(SDL2_Surface *surface, SDL2_RWops *rwops, int freedst)
 {
     int retval = -1;
-    SDL_IOStream *iostream = RWops2to3(rwops);
+    SDL_IOStream *iostream = RWops2to3_Acquire(rwops, false);
     if (iostream) {
-        retval = SDL3_SaveBMP_IO(Surface2to3(surface), iostream, true) ? 0 : -1;    /* always close the iostrm3 bridge object. */
+        retval = SDL3_SaveBMP_IO(Surface2to3(surface), iostream, false) ? 0 : -1;
+        if (!RWops2to3_Release(rwops, iostream)) {
+            retval = -1;
+        }
     }
     if (rwops && freedst) {
         SDL_RWclose(rwops);
@@ -4111,18 +5715,176 @@ SDL_SaveBMP_RW(SDL2_Surface *surface, SDL2_RWops *rwops, int freedst)
     return retval;
 }
 
+/* Several libraries in one app often load the same controller database, and SDL3 parses every line again each
+   time. The bulk loader remembers, for each GUID, a hash of the line that last set its mapping, and skips that
+   line while it still owns the GUID. Adding a mapping any other way forgets them all, since we can't tell which
+   GUID it replaced. */
+typedef struct SDL2_ControllerMappingHash
+{
+    Uint64 guid;  /* hash of the GUID field, 0 marks an empty slot. */
+    Uint64 line;  /* hash of the whole line currently mapped for it. */
+} SDL2_ControllerMappingHash;
+
+static SDL2_ControllerMappingHash *ControllerMappingHashes = NULL;  /* open addressing. */
+static int NumControllerMappingHashes = 0;
+static int MaxControllerMappingHashes = 0;  /* always a power of two. */
+static SDL_SpinLock ControllerMappingHashLock = 0;
+
+static Uint64 HashControllerMapping(const char *str, size_t len)
+{
+    Uint64 hash = 0xcbf29ce484222325ULL;  /* 64-bit FNV-1a */
+    while (len--) {
+        hash = (hash ^ (Uint8)*(str++)) * 0x100000001b3ULL;
+    }
+    return hash ? hash : 1;
+}
+
+/* call with ControllerMappingHashLock held. Returns the line hash currently stored for guid, or 0. */
+static Uint64 GetControllerMappingHash(Uint64 guid)
+{
+    int i;
+    if (!ControllerMappingHashes) {
+        return 0;
+    }
+    for (i = (int)(guid & (MaxControllerMappingHashes - 1)); ControllerMappingHashes[i].guid; i = (i + 1) & (MaxControllerMappingHashes - 1)) {
+        if (ControllerMappingHashes[i].guid == guid) {
+            return ControllerMappingHashes[i].line;
+        }
+    }
+    return 0;
+}
+
+/* call with ControllerMappingHashLock held. If this runs out of memory, the line is just loaded again next time. */
+static void SetControllerMappingHash(Uint64 guid, Uint64 line)
+{
+    int i;
+
+    if ((NumControllerMappingHashes + 1) * 2 > MaxControllerMappingHashes) {
+        const int new_max = MaxControllerMappingHashes ? (MaxControllerMappingHashes * 2) : 1024;
+        SDL2_ControllerMappingHash *new_hashes = (SDL2_ControllerMappingHash *)SDL3_calloc(new_max, sizeof(*new_hashes));
+        if (!new_hashes) {
+            return;
+        }
+        for (i = 0; i < MaxControllerMappingHashes; i++) {
+            if (ControllerMappingHashes[i].guid) {
+                int j = (int)(ControllerMappingHashes[i].guid & (new_max - 1));
+                while (new_hashes[j].guid) {
+                    j = (j + 1) & (new_max - 1);
+                }
+                new_hashes[j] = ControllerMappingHashes[i];
+            }
+        }
+        SDL3_free(ControllerMappingHashes);
+        ControllerMappingHashes = new_hashes;
+        MaxControllerMappingHashes = new_max;
+    }
+
+    for (i = (int)(guid & (MaxControllerMappingHashes - 1)); ControllerMappingHashes[i].guid; i = (i + 1) & (MaxControllerMappingHashes - 1)) {
+        if (ControllerMappingHashes[i].guid == guid) {
+            ControllerMappingHashes[i].line = line;
+            return;
+        }
+    }
+    ControllerMappingHashes[i].guid = guid;
+    ControllerMappingHashes[i].line = line;
+    NumControllerMappingHashes++;
+}
+
+static void ResetControllerMappingHashes(void)
+{
+    SDL3_LockSpinlock(&ControllerMappingHashLock);
+    SDL3_free(ControllerMappingHashes);
+    ControllerMappingHashes = NULL;
+    NumControllerMappingHashes = 0;
+    MaxControllerMappingHashes = 0;
+    SDL3_UnlockSpinlock(&ControllerMappingHashLock);
+}
+
+/* Like SDL2, only lines for this platform count, and the database says "Mac OS X" where SDL3 says "macOS". */
+static bool IsControllerMappingForPlatform(const char *line)
+{
+    const char *platform = SDL3_strstr(line, "platform:");
+    const char *end;
+    size_t len;
+
+    if (!platform) {
+        return false;
+    }
+    platform += 9;
+    end = SDL3_strchr(platform, ',');
+    if (!end) {
+        return false;
+    }
+    len = (size_t)(end - platform);
+    return (SDL3_strlen(SDL_GetPlatform()) == len && SDL3_strncasecmp(platform, SDL_GetPlatform(), len) == 0) ||
+           (SDL3_strlen(SDL3_GetPlatform()) == len && SDL3_strncasecmp(platform, SDL3_GetPlatform(), len) == 0);
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_GameControllerAddMapping(const char *mapping)
+{
+    ResetControllerMappingHashes();
+    return SDL3_AddGamepadMapping(mapping);
+}
+
 SDL_DECLSPEC int SDLCALL
 SDL_GameControllerAddMappingsFromRW(SDL2_RWops *rwops2, int freerw)
 {
-    int retval = -1;
-    SDL_IOStream *iostrm3 = RWops2to3(rwops2);
-    if (iostrm3) {
-        retval = SDL3_AddGamepadMappingsFromIO(iostrm3, true);    /* always close the iostrm3 bridge object. */
+    int added = 0;
+    char *data;
+    char *line;
+
+    if (!rwops2) {
+        SDL3_InvalidParamError("src");
+        return -1;
     }
-    if (rwops2 && freerw) {
-        SDL_RWclose(rwops2);
+
+    /* one read of the whole file, then one pass over it. */
+    data = (char *)SDL_LoadFile_RW(rwops2, NULL, freerw);
+    if (!data) {
+        return -1;
     }
-    return retval;
+
+    for (line = data; *line; ) {
+        char *next = SDL3_strchr(line, '\n');
+        char *end = next ? next : line + SDL3_strlen(line);
+
+        if (end > line && end[-1] == '\r') {
+            end--;
+        }
+        *end = '\0';
+
+        if (*line != '#' && IsControllerMappingForPlatform(line)) {
+            const Uint64 guid = HashControllerMapping(line, (size_t)(SDL3_strchr(line, ',') - line));  /* there is a ',' after "platform:". */
+            const Uint64 hash = HashControllerMapping(line, (size_t)(end - line));
+            bool known;
+
+            SDL3_LockSpinlock(&ControllerMappingHashLock);
+            known = (GetControllerMappingHash(guid) == hash);
+            SDL3_UnlockSpinlock(&ControllerMappingHashLock);
+
+            /* if it's known, SDL3 would have just updated it to what it already is. */
+            if (!known) {
+                const int rc = SDL3_AddGamepadMapping(line);
+                if (rc > 0) {
+                    added++;
+                }
+                if (rc >= 0) {
+                    SDL3_LockSpinlock(&ControllerMappingHashLock);
+                    SetControllerMappingHash(guid, hash);
+                    SDL3_UnlockSpinlock(&ControllerMappingHashLock);
+                }
+            }
+        }
+
+        if (!next) {
+            break;
+        }
+        line = next + 1;
+    }
+    SDL3_free(data);
+
+    return added;
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -4196,37 +5958,198 @@ SDL_CalculateGammaRamp(float gamma, Uint16 *ramp)
     }
 }
 
+/* Opt-in gamma ramp emulation for apps that draw to the window surface, see SDL2COMPAT_EMULATE_GAMMA in README.md.
+   The ramps are applied to the surface pixels just before they're presented, and the pixels are put back after,
+   so the app never sees the adjusted values. */
+typedef struct SDL2_GammaState
+{
+    Uint8 lut[3][256];  /* the ramps reduced to 8 bits: red, green, blue. */
+    Uint8 *saved;       /* unadjusted pixels, put back after presenting. */
+    size_t saved_size;
+} SDL2_GammaState;
+
+static void SDLCALL CleanupGammaState(void *userdata, void *value)
+{
+    SDL2_GammaState *state = (SDL2_GammaState *)value;
+    SDL3_free(state->saved);
+    SDL3_free(state);
+}
+
+static int UpdateGammaState(SDL_Window *window, const Uint16 *gamma)
+{
+    const SDL_PropertiesID props = SDL3_GetWindowProperties(window);
+    SDL2_GammaState *state;
+    bool identity = true;
+    int i, j;
+
+    for (i = 0; i < 3 && identity; ++i) {
+        for (j = 0; j < 256; ++j) {
+            if ((gamma[i * 256 + j] >> 8) != j) {
+                identity = false;
+                break;
+            }
+        }
+    }
+    if (identity) {
+        /* nothing to do when presenting. */
+        SDL3_ClearProperty(props, PROP_WINDOW_GAMMA_STATE_POINTER);
+        return 0;
+    }
+
+    state = (SDL2_GammaState *)SDL3_GetPointerProperty(props, PROP_WINDOW_GAMMA_STATE_POINTER, NULL);
+    if (!state) {
+        state = (SDL2_GammaState *)SDL3_calloc(1, sizeof(*state));
+        if (!state) {
+            return -1;
+        }
+        /* the cleanup callback frees state if this fails. */
+        if (!SDL3_SetPointerPropertyWithCleanup(props, PROP_WINDOW_GAMMA_STATE_POINTER, state, CleanupGammaState, NULL)) {
+            return -1;
+        }
+    }
+    for (i = 0; i < 3; ++i) {
+        for (j = 0; j < 256; ++j) {
+            state->lut[i][j] = (Uint8)(gamma[i * 256 + j] >> 8);
+        }
+    }
+    return 0;
+}
+
 SDL_DECLSPEC int SDLCALL
 SDL_SetWindowGammaRamp(SDL_Window *window, const Uint16 *r, const Uint16 *g, const Uint16 *b)
 {
+    Uint16 *gamma;
+
     if (!window) {
         SDL3_SetError("Invalid window");
         return -1;
     }
 
-    SDL3_Unsupported();
-    return -1;
+    if (!SDL3_GetHintBoolean("SDL2COMPAT_EMULATE_GAMMA", false)) {
+        SDL3_Unsupported();
+        return -1;
+    }
 
-#if 0 /* Leaving this code here in case we need it for a compatibility quirk */
-    Uint16 *gamma = (Uint16 *)SDL3_GetPointerProperty(SDL3_GetWindowProperties(window), PROP_WINDOW_GAMMA_RAMP, NULL);
+    gamma = (Uint16 *)SDL3_GetPointerProperty(SDL3_GetWindowProperties(window), PROP_WINDOW_GAMMA_RAMP, NULL);
     if (!gamma) {
         if (SDL_GetWindowGammaRamp(window, NULL, NULL, NULL) < 0) {
             return -1;
         }
         gamma = (Uint16 *)SDL3_GetPointerProperty(SDL3_GetWindowProperties(window), PROP_WINDOW_GAMMA_RAMP, NULL);
+        if (!gamma) {
+            return -1;
+        }
     }
 
     if (r) {
-        SDL_memcpy(&gamma[0*256], r, 256*sizeof(Uint16));
+        SDL3_memcpy(&gamma[0*256], r, 256*sizeof(Uint16));
     }
     if (g) {
-        SDL_memcpy(&gamma[1*256], g, 256*sizeof(Uint16));
+        SDL3_memcpy(&gamma[1*256], g, 256*sizeof(Uint16));
     }
     if (b) {
-        SDL_memcpy(&gamma[2*256], b, 256*sizeof(Uint16));
+        SDL3_memcpy(&gamma[2*256], b, 256*sizeof(Uint16));
     }
-    return 0;
-#endif
+    return UpdateGammaState(window, gamma);
+}
+
+static void ApplyGammaRow(Uint32 *pixels, int w, const SDL2_GammaState *state, Uint8 Rshift, Uint8 Gshift, Uint8 Bshift)
+{
+    const Uint32 keep = ~((0xFFu << Rshift) | (0xFFu << Gshift) | (0xFFu << Bshift));
+    int x;
+
+    for (x = 0; x < w; ++x) {
+        const Uint32 pixel = pixels[x];
+        pixels[x] = (pixel & keep) |
+                    ((Uint32)state->lut[0][(Uint8)(pixel >> Rshift)] << Rshift) |
+                    ((Uint32)state->lut[1][(Uint8)(pixel >> Gshift)] << Gshift) |
+                    ((Uint32)state->lut[2][(Uint8)(pixel >> Bshift)] << Bshift);
+    }
+}
+
+/* rects is NULL to present the whole surface. */
+static bool UpdateWindowSurfaceWithGamma(SDL_Window *window, const SDL_Rect *rects, int numrects)
+{
+    SDL2_GammaState *state = NULL;
+    const SDL_PixelFormatDetails *details = NULL;
+    SDL_Surface *surface = NULL;
+    SDL_Rect bounds, area;
+    size_t row_bytes, needed;
+    bool result;
+    int i, y;
+
+    if (window) {
+        state = (SDL2_GammaState *)SDL3_GetPointerProperty(SDL3_GetWindowProperties(window), PROP_WINDOW_GAMMA_STATE_POINTER, NULL);
+    }
+    if (state) {
+        surface = SDL3_GetWindowSurface(window);
+    }
+    if (surface && SDL_BYTESPERPIXEL(surface->format) == 4 && !SDL_ISPIXELFORMAT_INDEXED(surface->format) && !SDL_MUSTLOCK(surface)) {
+        details = SDL3_GetPixelFormatDetails(surface->format);
+    }
+    if (!details || details->Rbits != 8 || details->Gbits != 8 || details->Bbits != 8) {
+        return rects ? SDL3_UpdateWindowSurfaceRects(window, rects, numrects) : SDL3_UpdateWindowSurface(window);
+    }
+
+    /* Adjust the bounds of everything being presented once, so overlapping rects don't get adjusted twice. */
+    bounds.x = bounds.y = 0;
+    bounds.w = surface->w;
+    bounds.h = surface->h;
+    if (rects) {
+        SDL_Rect clipped;
+        SDL3_zero(area);
+        for (i = 0; i < numrects; ++i) {
+            if (SDL3_GetRectIntersection(&rects[i], &bounds, &clipped)) {
+                if (area.w > 0 && area.h > 0) {
+                    SDL3_GetRectUnion(&area, &clipped, &area);
+                } else {
+                    area = clipped;
+                }
+            }
+        }
+    } else {
+        area = bounds;
+    }
+    if (area.w <= 0 || area.h <= 0) {
+        return rects ? SDL3_UpdateWindowSurfaceRects(window, rects, numrects) : SDL3_UpdateWindowSurface(window);
+    }
+
+    row_bytes = (size_t)area.w * 4;
+    needed = row_bytes * area.h;
+    if (needed > state->saved_size) {
+        Uint8 *saved = (Uint8 *)SDL3_realloc(state->saved, needed);
+        if (!saved) {
+            return false;
+        }
+        state->saved = saved;
+        state->saved_size = needed;
+    }
+
+    for (y = 0; y < area.h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)(area.y + y) * surface->pitch) + area.x;
+        SDL3_memcpy(state->saved + row_bytes * y, row, row_bytes);
+        ApplyGammaRow(row, area.w, state, details->Rshift, details->Gshift, details->Bshift);
+    }
+
+    result = rects ? SDL3_UpdateWindowSurfaceRects(window, rects, numrects) : SDL3_UpdateWindowSurface(window);
+
+    for (y = 0; y < area.h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + (size_t)(area.y + y) * surface->pitch) + area.x;
+        SDL3_memcpy(row, state->saved + row_bytes * y, row_bytes);
+    }
+    return result;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_UpdateWindowSurface(SDL_Window *window)
+{
+    return UpdateWindowSurfaceWithGamma(window, NULL, 0) ? 0 : -1;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects, int numrects)
+{
+    return UpdateWindowSurfaceWithGamma(window, rects, numrects) ? 0 : -1;
 }
 
 static void SDLCALL CleanupFreeableProperty(void *userdata, void *value)
@@ -4235,7 +6158,7 @@ static void SDLCALL CleanupFreeableProperty(void *userdata, void *value)
 }
 
 SDL_DECLSPEC int SDLCALL
-SDL_GetWindowGammaRamp(SDL_Window *window, Uint16 *red, Uint16 *blue, Uint16 *green)
+SDL_GetWindowGammaRamp(SDL_Window *window, Uint16 *red, Uint16 *green, Uint16 *blue)
 {
     Uint16 *gamma;
 
@@ -4289,6 +6212,80 @@ SDL_GetWindowOpacity(SDL_Window *window, float *out_opacity)
     return 0;
 }
 
+/* Converting to the surface's own format is a copy. If nothing about the surface would need carrying over to the
+   new one, do that directly instead of setting up an SDL3 blit for it. 8-bit indexed surfaces, like old sprites,
+   are copied too if the target palette has the same colors, so no index needs remapping. palette is the target
+   palette, or NULL to keep the surface's own. Returns NULL to let SDL3 do the conversion. */
+static SDL_Surface *ConvertSurfaceByCopy(SDL_Surface *surface, SDL_PixelFormat format, const SDL_Palette *palette)
+{
+    const SDL_BlendMode default_blend = SDL_ISPIXELFORMAT_ALPHA(format) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE;
+    const bool indexed = (format == SDL_PIXELFORMAT_INDEX8);
+    SDL_BlendMode blend;
+    Uint8 r, g, b, a;
+    SDL_Surface *convert;
+    size_t row_bytes;
+    int y;
+
+    if (!surface || surface->format != format || !surface->pixels ||
+        !SDL3_GetHintBoolean("SDL2COMPAT_CONVERT_BY_COPY", true) ||
+        (SDL_ISPIXELFORMAT_INDEXED(format) && !indexed) || SDL_ISPIXELFORMAT_FOURCC(format) ||
+        SDL3_GetSurfaceColorspace(surface) != SDL_COLORSPACE_SRGB || SDL3_SurfaceHasRLE(surface) ||
+        !SDL3_GetSurfaceBlendMode(surface, &blend) ||
+        !SDL3_GetSurfaceColorMod(surface, &r, &g, &b) ||
+        !SDL3_GetSurfaceAlphaMod(surface, &a)) {
+        return NULL;
+    }
+
+    if (indexed) {
+        const SDL_Palette *src_palette = SDL3_GetSurfacePalette(surface);
+        if (!src_palette) {
+            return NULL;
+        }
+        if (!palette) {
+            palette = src_palette;
+        }
+        if (palette->ncolors != src_palette->ncolors ||
+            SDL3_memcmp(palette->colors, src_palette->colors, palette->ncolors * sizeof(*palette->colors)) != 0 ||
+            (blend != SDL_BLENDMODE_NONE && blend != SDL_BLENDMODE_BLEND)) {
+            return NULL;
+        }
+    } else if (SDL3_SurfaceHasColorKey(surface) || blend != default_blend || (r & g & b) != 255 || a != 255) {
+        return NULL;
+    }
+
+    convert = SDL3_CreateSurface(surface->w, surface->h, format);
+    if (!convert) {
+        return NULL;
+    }
+    row_bytes = (size_t)surface->w * SDL_BYTESPERPIXEL(format);
+    for (y = 0; y < surface->h; ++y) {
+        SDL3_memcpy((Uint8 *)convert->pixels + (size_t)y * convert->pitch, (const Uint8 *)surface->pixels + (size_t)y * surface->pitch, row_bytes);
+    }
+
+    if (indexed) {
+        /* The new surface gets its own palette, as in SDL2. Past that, carry over what SDL3's conversion does:
+           the mods, the color key (the same index, since the colors match), and blending only for alpha mod. */
+        SDL_Palette *dst_palette = SDL3_GetSurfacePalette(convert);
+        Uint32 key;
+
+        if (!dst_palette) {
+            dst_palette = SDL3_CreateSurfacePalette(convert);
+        }
+        if (!dst_palette || dst_palette->ncolors != palette->ncolors ||
+            !SDL3_SetPaletteColors(dst_palette, palette->colors, 0, palette->ncolors)) {
+            SDL3_DestroySurface(convert);
+            return NULL;
+        }
+        if (SDL3_GetSurfaceColorKey(surface, &key)) {
+            SDL3_SetSurfaceColorKey(convert, true, key);
+        }
+        SDL3_SetSurfaceColorMod(convert, r, g, b);
+        SDL3_SetSurfaceAlphaMod(convert, a);
+        SDL3_SetSurfaceBlendMode(convert, (a != 255) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    }
+    return convert;
+}
+
 SDL_DECLSPEC SDL2_Surface * SDLCALL
 SDL_ConvertSurface(SDL2_Surface *surface, const SDL2_PixelFormat *format, Uint32 flags)
 {
@@ -4315,6 +6312,13 @@ SDL_ConvertSurface(SDL2_Surface *surface, const SDL2_PixelFormat *format, Uint32
         return NULL;
     }
 
+    if (!format->palette || pixel_format == SDL_PIXELFORMAT_INDEX8) {
+        SDL_Surface *convert = ConvertSurfaceByCopy(Surface2to3(surface), pixel_format, format->palette);
+        if (convert) {
+            return NewSurface3to2(convert);
+        }
+    }
+
     if (format->palette) {
         // This conversion is going to assign the new surface this palette,
         // but it might be on the stack, so always allocate a new one to be
@@ -4327,7 +6331,7 @@ SDL_ConvertSurface(SDL2_Surface *surface, const SDL2_PixelFormat *format, Uint32
         SDL3_SetPaletteColors(palette, format->palette->colors, 0, ncolors);
     }
 
-    result = Surface3to2(SDL3_ConvertSurfaceAndColorspace(Surface2to3(surface), pixel_format, palette, SDL_COLORSPACE_SRGB, 0));
+    result = NewSurface3to2(SDL3_ConvertSurfaceAndColorspace(Surface2to3(surface), pixel_format, palette, SDL_COLORSPACE_SRGB, 0));
 
     if (palette) {
         SDL3_DestroyPalette(palette);
@@ -4344,8 +6348,14 @@ SDL_DuplicateSurface(SDL2_Surface *surface)
 SDL_DECLSPEC SDL2_Surface * SDLCALL
 SDL_ConvertSurfaceFormat(SDL2_Surface *surface, Uint32 pixel_format, Uint32 flags)
 {
+    SDL_Surface *surface3 = Surface2to3(surface);
+    SDL_Surface *convert = ConvertSurfaceByCopy(surface3, (SDL_PixelFormat)pixel_format, NULL);
+
     (void) flags; /* SDL3 removed the (unused) `flags` argument */
-    return Surface3to2(SDL3_ConvertSurface(Surface2to3(surface), (SDL_PixelFormat)pixel_format));
+    if (!convert) {
+        convert = SDL3_ConvertSurface(surface3, (SDL_PixelFormat)pixel_format);
+    }
+    return NewSurface3to2(convert);
 }
 
 #define SDL_YUV_SD_THRESHOLD 576
@@ -4417,25 +6427,25 @@ SDL_CreateRGBSurface(Uint32 flags, int width, int height, int depth, Uint32 Rmas
         SDL3_SetError("Unknown pixel format");
         return NULL;
     }
-    return Surface3to2(SDL3_CreateSurface(width, height, format));
+    return NewSurface3to2(SDL3_CreateSurface(width, height, format));
 }
 
 SDL_DECLSPEC SDL2_Surface * SDLCALL
 SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth, Uint32 format)
 {
-    return Surface3to2(SDL3_CreateSurface(width, height, (SDL_PixelFormat)format));
+    return NewSurface3to2(SDL3_CreateSurface(width, height, (SDL_PixelFormat)format));
 }
 
 SDL_DECLSPEC SDL2_Surface * SDLCALL
 SDL_CreateRGBSurfaceFrom(void *pixels, int width, int height, int depth, int pitch, Uint32 Rmask, Uint32 Gmask, Uint32 Bmask, Uint32 Amask)
 {
-    return Surface3to2(SDL3_CreateSurfaceFrom(width, height, SDL3_GetPixelFormatForMasks(depth, Rmask, Gmask, Bmask, Amask), pixels, pitch));
+    return NewSurface3to2(SDL3_CreateSurfaceFrom(width, height, SDL3_GetPixelFormatForMasks(depth, Rmask, Gmask, Bmask, Amask), pixels, pitch));
 }
 
 SDL_DECLSPEC SDL2_Surface * SDLCALL
 SDL_CreateRGBSurfaceWithFormatFrom(void *pixels, int width, int height, int depth, int pitch, Uint32 format)
 {
-    return Surface3to2(SDL3_CreateSurfaceFrom(width, height, (SDL_PixelFormat)format, pixels, pitch));
+    return NewSurface3to2(SDL3_CreateSurfaceFrom(width, height, (SDL_PixelFormat)format, pixels, pitch));
 }
 
 SDL_DECLSPEC void SDLCALL
@@ -4464,7 +6474,7 @@ SDL_FreeSurface(SDL2_Surface *surface)
         surface->format = NULL;
     }
 
-    SDL3_free(surface);
+    ReleaseSurface2(surface);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -4479,11 +6489,8 @@ SDL_FillRects(SDL2_Surface *dst, const SDL_Rect *rects, int count, Uint32 color)
     return SDL3_FillSurfaceRects(Surface2to3(dst), rects, count, color) ? 0 : -1;
 }
 
-SDL_DECLSPEC int SDLCALL
-SDL_UpperBlit(SDL2_Surface *src, const SDL_Rect *srcrect, SDL2_Surface *dst, SDL_Rect *dstrect)
+static int CheckBlitSurfaces(SDL2_Surface *src, SDL2_Surface *dst)
 {
-    SDL_Rect r_src, r_dst;
-
     /* Make sure the surfaces aren't locked */
     if (!src) {
         SDL3_InvalidParamError("src");
@@ -4495,65 +6502,81 @@ SDL_UpperBlit(SDL2_Surface *src, const SDL_Rect *srcrect, SDL2_Surface *dst, SDL
         SDL3_SetError("Surfaces must not be locked during blit");
         return -1;
     }
+    return 0;
+}
 
+/* Clips a blit like SDL_UpperBlit() does. Returns false if there's nothing left to blit. */
+static bool ClipBlitRects(const SDL2_Surface *src, const SDL_Rect *srcrect, const SDL2_Surface *dst, const SDL_Rect *dstrect, SDL_Rect *r_src, SDL_Rect *r_dst)
+{
     /* Full src surface */
-    r_src.x = 0;
-    r_src.y = 0;
-    r_src.w = src->w;
-    r_src.h = src->h;
+    r_src->x = 0;
+    r_src->y = 0;
+    r_src->w = src->w;
+    r_src->h = src->h;
 
     if (dstrect) {
-        r_dst.x = dstrect->x;
-        r_dst.y = dstrect->y;
+        r_dst->x = dstrect->x;
+        r_dst->y = dstrect->y;
     } else {
-        r_dst.x = 0;
-        r_dst.y = 0;
+        r_dst->x = 0;
+        r_dst->y = 0;
     }
 
     /* clip the source rectangle to the source surface */
     if (srcrect) {
         SDL_Rect tmp;
-        if (!SDL3_GetRectIntersection(srcrect, &r_src, &tmp)) {
-            goto end;
+        if (!SDL3_GetRectIntersection(srcrect, r_src, &tmp)) {
+            return false;
         }
 
         /* Shift dstrect, if srcrect origin has changed */
-        r_dst.x += tmp.x - srcrect->x;
-        r_dst.y += tmp.y - srcrect->y;
+        r_dst->x += tmp.x - srcrect->x;
+        r_dst->y += tmp.y - srcrect->y;
 
         /* Update srcrect */
-        r_src = tmp;
+        *r_src = tmp;
     }
 
     /* There're no dstrect.w/h parameters. It's the same as srcrect */
-    r_dst.w = r_src.w;
-    r_dst.h = r_src.h;
+    r_dst->w = r_src->w;
+    r_dst->h = r_src->h;
 
     /* clip the destination rectangle against the clip rectangle */
     {
         SDL_Rect tmp;
-        if (!SDL3_GetRectIntersection(&r_dst, &dst->clip_rect, &tmp)) {
-            goto end;
+        if (!SDL3_GetRectIntersection(r_dst, &dst->clip_rect, &tmp)) {
+            return false;
         }
 
         /* Shift srcrect, if dstrect has changed */
-        r_src.x += tmp.x - r_dst.x;
-        r_src.y += tmp.y - r_dst.y;
-        r_src.w = tmp.w;
-        r_src.h = tmp.h;
+        r_src->x += tmp.x - r_dst->x;
+        r_src->y += tmp.y - r_dst->y;
+        r_src->w = tmp.w;
+        r_src->h = tmp.h;
 
         /* Update dstrect */
-        r_dst = tmp;
+        *r_dst = tmp;
+    }
+
+    return (r_dst->w > 0 && r_dst->h > 0);
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_UpperBlit(SDL2_Surface *src, const SDL_Rect *srcrect, SDL2_Surface *dst, SDL_Rect *dstrect)
+{
+    SDL_Rect r_src, r_dst;
+
+    if (CheckBlitSurfaces(src, dst) < 0) {
+        return -1;
     }
 
-    if (r_dst.w > 0 && r_dst.h > 0) {
+    if (ClipBlitRects(src, srcrect, dst, dstrect, &r_src, &r_dst)) {
         if (dstrect) { /* update output parameter */
             *dstrect = r_dst;
         }
         return SDL_LowerBlit(src, &r_src, dst, &r_dst);
     }
 
-end:
     if (dstrect) { /* update output parameter */
         dstrect->w = dstrect->h = 0;
     }
@@ -4571,6 +6594,45 @@ SDL_LowerBlit(SDL2_Surface *src2, SDL_Rect *srcrect, SDL2_Surface *dst2, SDL_Rec
     return result;
 }
 
+/* sdl2-compat extension, looked up with SDL_GL_GetProcAddress("SDL2Compat_BlitSurfaces").
+   Does the same as calling SDL_UpperBlit() for each pair of rects, but checks and synchronizes the surfaces once.
+   srcrects may be NULL to blit the whole source each time, and dstrects may be NULL to blit to 0,0 each time;
+   otherwise dstrects are updated like SDL_UpperBlit() does. Returns -1 if any of the blits failed. */
+static int SDLCALL SDL2Compat_BlitSurfaces(SDL2_Surface *src2, const SDL_Rect *srcrects, SDL2_Surface *dst2, SDL_Rect *dstrects, int count)
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_Rect r_src, r_dst;
+    int result = 0;
+    int i;
+
+    if (CheckBlitSurfaces(src2, dst2) < 0) {
+        return -1;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    src = Surface2to3(src2);
+    dst = Surface2to3(dst2);
+    for (i = 0; i < count; ++i) {
+        SDL_Rect *dstrect = dstrects ? &dstrects[i] : NULL;
+        if (ClipBlitRects(src2, srcrects ? &srcrects[i] : NULL, dst2, dstrect, &r_src, &r_dst)) {
+            if (dstrect) {
+                *dstrect = r_dst;
+            }
+            if (!SDL3_BlitSurfaceUnchecked(src, &r_src, dst, &r_dst)) {
+                result = -1;
+            }
+        } else if (dstrect) {
+            dstrect->w = dstrect->h = 0;
+        }
+    }
+    SynchronizeSurface3to2(src, src2);
+    SynchronizeSurface3to2(dst, dst2);
+    return result;
+}
+
 SDL_DECLSPEC int SDLCALL
 SDL_UpperBlitScaled(SDL2_Surface *src, const SDL_Rect *srcrect, SDL2_Surface *dst, SDL_Rect *dstrect)
 {
@@ -5615,21 +7677,140 @@ GestureProcessEvent(const SDL_Event *event3)
 }
 
 
+/* What a shape pixel has to look like to be part of the window. The alpha modes all come down to an alpha range,
+   so the mode only has to be looked at once, not per pixel. */
+typedef struct SDL2_ShapeTest
+{
+    bool colorkey;
+    Uint8 alpha_min;  /* inclusive */
+    Uint8 alpha_max;  /* inclusive */
+    SDL_Color key;
+} SDL2_ShapeTest;
+
+static void GetShapeTest(const SDL_WindowShapeMode *mode, SDL2_ShapeTest *test)
+{
+    SDL3_zerop(test);
+    test->alpha_max = 255;
+    switch (mode->mode) {
+    case ShapeModeDefault:
+        test->alpha_min = 1;
+        break;
+    case ShapeModeBinarizeAlpha:
+        test->alpha_min = mode->parameters.binarizationCutoff;
+        break;
+    case ShapeModeReverseBinarizeAlpha:
+        test->alpha_max = mode->parameters.binarizationCutoff;
+        break;
+    case ShapeModeColorKey:
+        test->colorkey = true;
+        test->key = mode->parameters.colorKey;
+        break;
+    }
+}
+
+static Uint32 GetShapeMaskValue(const SDL2_ShapeTest *test, Uint8 r, Uint8 g, Uint8 b, Uint8 alpha)
+{
+    if (test->colorkey) {
+        return (test->key.r != r || test->key.g != g || test->key.b != b) ? 0xFFFFFFFF : 0;
+    }
+    return (alpha >= test->alpha_min && alpha <= test->alpha_max) ? 0xFFFFFFFF : 0;
+}
+
+/* The row kernels below are branchless so the compiler can vectorize them. */
+static void CalculateShapeRowAlpha32(const Uint32 *src, Uint32 *dst, int w, Uint8 Ashift, Uint8 alpha_min, Uint8 alpha_range)
+{
+    int x;
+    for (x = 0; x < w; x++) {
+        const Uint8 alpha = (Uint8)(src[x] >> Ashift);
+        dst[x] = 0u - (Uint32)((Uint8)(alpha - alpha_min) <= alpha_range);
+    }
+}
+
+static void CalculateShapeRowColorKey32(const Uint32 *src, Uint32 *dst, int w, Uint32 rgbmask, Uint32 key)
+{
+    int x;
+    for (x = 0; x < w; x++) {
+        dst[x] = 0u - (Uint32)((src[x] & rgbmask) != key);
+    }
+}
+
+static void CalculateShapeRowTable8(const Uint8 *src, Uint32 *dst, int w, const Uint32 *table)
+{
+    int x;
+    for (x = 0; x < w; x++) {
+        dst[x] = table[src[x]];
+    }
+}
+
 /* REQUIRES that bitmap point to a w-by-h bitmap with ppb pixels-per-byte. */
 static void SDL_CalculateShapeBitmap(SDL_WindowShapeMode mode, SDL2_Surface *shape, Uint32 *pixels, int pitch)
 {
+    const SDL2_PixelFormat *format = shape->format;
+    const Uint8 *shape_row = (const Uint8 *)shape->pixels;
     int x = 0;
     int y = 0;
     Uint8 r = 0, g = 0, b = 0, alpha = 0;
-    Uint32 pixel_value = 0, mask_value = 0;
-    SDL_Color key;
+    Uint32 pixel_value = 0;
+    SDL2_ShapeTest test;
+
+    GetShapeTest(&mode, &test);
+
+    if (format->BytesPerPixel == 1) {
+        /* Every possible pixel value fits in a table, indexed or not. */
+        Uint32 table[256];
+        for (pixel_value = 0; pixel_value < SDL_arraysize(table); pixel_value++) {
+            SDL_GetRGBA(pixel_value, shape->format, &r, &g, &b, &alpha);
+            table[pixel_value] = GetShapeMaskValue(&test, r, g, b, alpha);
+        }
+        for (y = 0; y < shape->h; y++) {
+            CalculateShapeRowTable8(shape_row, pixels, shape->w, table);
+            shape_row += shape->pitch;
+            pixels = (Uint32 *)((Uint8 *)pixels + pitch);
+        }
+        return;
+    }
+
+    if (format->BytesPerPixel == 4 && !format->palette) {
+        if (!test.colorkey && format->Amask == 0) {
+            /* No alpha channel, so every pixel gets the same alpha. */
+            Uint32 mask_value;
+            SDL_GetRGBA(0, shape->format, &r, &g, &b, &alpha);
+            mask_value = GetShapeMaskValue(&test, r, g, b, alpha);
+            for (y = 0; y < shape->h; y++) {
+                for (x = 0; x < shape->w; x++) {
+                    pixels[x] = mask_value;
+                }
+                pixels = (Uint32 *)((Uint8 *)pixels + pitch);
+            }
+            return;
+        }
+        if (!test.colorkey && format->Amask == (0xFFu << format->Ashift)) {
+            for (y = 0; y < shape->h; y++) {
+                CalculateShapeRowAlpha32((const Uint32 *)shape_row, pixels, shape->w, format->Ashift, test.alpha_min, (Uint8)(test.alpha_max - test.alpha_min));
+                shape_row += shape->pitch;
+                pixels = (Uint32 *)((Uint8 *)pixels + pitch);
+            }
+            return;
+        }
+        if (test.colorkey && format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0) {
+            /* With 8 bits per channel, comparing the colors is comparing the bits. */
+            const Uint32 rgbmask = format->Rmask | format->Gmask | format->Bmask;
+            const Uint32 key = ((Uint32)test.key.r << format->Rshift) | ((Uint32)test.key.g << format->Gshift) | ((Uint32)test.key.b << format->Bshift);
+            for (y = 0; y < shape->h; y++) {
+                CalculateShapeRowColorKey32((const Uint32 *)shape_row, pixels, shape->w, rgbmask, key);
+                shape_row += shape->pitch;
+                pixels = (Uint32 *)((Uint8 *)pixels + pitch);
+            }
+            return;
+        }
+    }
 
     for (y = 0; y < shape->h; y++) {
         for (x = 0; x < shape->w; x++) {
-            const Uint8 *shape_pixels = (Uint8 *)(shape->pixels) + (y * shape->pitch) + (x * shape->format->BytesPerPixel);
+            const Uint8 *shape_pixels = shape_row + (x * format->BytesPerPixel);
             alpha = 0;
             pixel_value = 0;
-            switch (shape->format->BytesPerPixel) {
+            switch (format->BytesPerPixel) {
             case 1:
                 pixel_value = *shape_pixels;
                 break;
@@ -5637,30 +7818,16 @@ static void SDL_CalculateShapeBitmap(SDL_WindowShapeMode mode, SDL2_Surface *sha
                 pixel_value = *(Uint16 *)shape_pixels;
                 break;
             case 3:
-                pixel_value = *(Uint32 *)shape_pixels & (~shape->format->Amask);
+                pixel_value = *(Uint32 *)shape_pixels & (~format->Amask);
                 break;
             case 4:
                 pixel_value = *(Uint32 *)shape_pixels;
                 break;
             }
             SDL_GetRGBA(pixel_value, shape->format, &r, &g, &b, &alpha);
-            switch (mode.mode) {
-            case (ShapeModeDefault):
-                mask_value = (alpha >= 1 ? 0xFFFFFFFF : 0);
-                break;
-            case (ShapeModeBinarizeAlpha):
-                mask_value = (alpha >= mode.parameters.binarizationCutoff ? 0xFFFFFFFF : 0);
-                break;
-            case (ShapeModeReverseBinarizeAlpha):
-                mask_value = (alpha <= mode.parameters.binarizationCutoff ? 0xFFFFFFFF : 0);
-                break;
-            case (ShapeModeColorKey):
-                key = mode.parameters.colorKey;
-                mask_value = ((key.r != r || key.g != g || key.b != b) ? 0xFFFFFFFF : 0);
-                break;
-            }
-            pixels[x] = mask_value;
+            pixels[x] = GetShapeMaskValue(&test, r, g, b, alpha);
         }
+        shape_row += shape->pitch;
         pixels = (Uint32 *)((Uint8 *)pixels + pitch);
     }
 }
@@ -5922,15 +8089,683 @@ SDL_GetRenderDriverInfo(int idx, SDL2_RendererInfo *info)
     return 0;
 }
 
-static int FlushRendererIfNotBatching(SDL_Renderer *renderer)
+/* SDL2 state for a texture that would otherwise need several property lookups to query.
+   This is filled in once when the texture is created and reached through a single pointer property. */
+typedef struct SDL2_TextureInfo
+{
+    Uint32 format;
+    int access;
+    int w;
+    int h;
+    SDL_Colorspace colorspace;
+    SDL_ScaleMode scale_mode;  /* what the app asked for, which might be SDL2's SDL_ScaleModeBest. */
+    bool locked;
+    SDL2_Surface *lock_surface;  /* reused by every SDL_LockTextureToSurface(), map is NULL while unlocked. */
+
+    /* GL names for SDL_GL_BindTexture(), looked up on first use. */
+    int gl_api;
+    GLenum gl_target;
+    GLuint gl_texture;
+    GLuint gl_texture_uv;
+    GLuint gl_texture_u;
+    GLuint gl_texture_v;
+    float gl_texw;
+    float gl_texh;
+} SDL2_TextureInfo;
+
+#define SDL2_TEXTURE_GL_API_UNKNOWN 0
+#define SDL2_TEXTURE_GL_API_NONE 1
+#define SDL2_TEXTURE_GL_API_OPENGL 2
+#define SDL2_TEXTURE_GL_API_OPENGLES2 3
+
+static void SDLCALL CleanupTextureInfo(void *userdata, void *value)
+{
+    SDL2_TextureInfo *info = (SDL2_TextureInfo *)value;
+    if (info->lock_surface) {
+        info->lock_surface->flags &= ~SDL_DONTFREE;
+        info->lock_surface->map = NULL;  /* SDL3 destroys the locked surface itself. */
+        SDL_FreeSurface(info->lock_surface);
+    }
+    SDL3_free(info);
+}
+
+static SDL2_TextureInfo *CreateTextureInfo(SDL_Texture *texture, SDL_PropertiesID props)
+{
+    SDL2_TextureInfo *info = (SDL2_TextureInfo *)SDL3_calloc(1, sizeof(*info));
+    if (!info) {
+        return NULL;
+    }
+
+    info->format = (Uint32)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
+    info->access = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
+    info->w = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_WIDTH_NUMBER, 0);
+    info->h = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_HEIGHT_NUMBER, 0);
+    info->colorspace = (SDL_Colorspace)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_COLORSPACE_NUMBER, SDL_COLORSPACE_SRGB);
+    if (!SDL3_GetTextureScaleMode(texture, &info->scale_mode)) {
+        info->scale_mode = SDL_SCALEMODE_LINEAR;
+    }
+
+    /* the cleanup callback frees info if this fails. */
+    if (!SDL3_SetPointerPropertyWithCleanup(props, PROP_TEXTURE_INFO_POINTER, info, CleanupTextureInfo, NULL)) {
+        return NULL;
+    }
+    return info;
+}
+
+static SDL2_TextureInfo *GetTextureInfo(SDL_Texture *texture)
+{
+    const SDL_PropertiesID props = SDL3_GetTextureProperties(texture);
+    SDL2_TextureInfo *info;
+
+    if (!props) {
+        return NULL;
+    }
+
+    info = (SDL2_TextureInfo *)SDL3_GetPointerProperty(props, PROP_TEXTURE_INFO_POINTER, NULL);
+    if (!info) {
+        /* not created through SDL_CreateTexture*(), build it now. */
+        info = CreateTextureInfo(texture, props);
+    }
+    return info;
+}
+
+/* Opt-in per-frame renderer statistics, see SDL2COMPAT_RENDER_STATS in README.md. */
+typedef enum SDL2_RenderStatsCall
+{
+    SDL2_RENDER_STATS_CLEAR,
+    SDL2_RENDER_STATS_POINTS,
+    SDL2_RENDER_STATS_LINES,
+    SDL2_RENDER_STATS_RECTS,
+    SDL2_RENDER_STATS_FILL_RECTS,
+    SDL2_RENDER_STATS_COPY,
+    SDL2_RENDER_STATS_COPY_EX,
+    SDL2_RENDER_STATS_GEOMETRY,
+    SDL2_RENDER_STATS_NUM_CALLS
+} SDL2_RenderStatsCall;
+
+static const char *const RenderStatsCallNames[SDL2_RENDER_STATS_NUM_CALLS] = {
+    "clear", "points", "lines", "rects", "fill_rects", "copy", "copy_ex", "geometry"
+};
+
+/* every field is a Uint64 counter, see AddRenderFrameStats(). */
+typedef struct SDL2_RenderFrameStats
+{
+    Uint64 calls[SDL2_RENDER_STATS_NUM_CALLS];
+    Uint64 vertices;
+    Uint64 flushes;
+    Uint64 texture_creates;
+    Uint64 texture_updates;
+    Uint64 texture_update_bytes;
+    Uint64 texture_locks;
+    Uint64 texture_lock_bytes;
+    Uint64 target_switches;
+    Uint64 readbacks;
+    Uint64 readback_bytes;
+} SDL2_RenderFrameStats;
+
+typedef struct SDL2_RenderStats
+{
+    int id;
+    Uint64 frame;
+    SDL2_RenderFrameStats current;   /* since the last SDL_RenderPresent(). */
+    SDL2_RenderFrameStats interval;  /* summed over the frames since we last logged. */
+    int interval_frames;
+    int log_interval;  /* frames between log messages, 0 to not log. */
+    bool csv;          /* holds a reference to RenderStatsFile. */
+} SDL2_RenderStats;
+
+static bool WantRenderStats = false;  /* true once any renderer collects stats, so everything else pays a single check. */
+static int RenderStatsNextId = 0;
+static SDL_IOStream *RenderStatsFile = NULL;  /* shared by all renderers, one row per renderer per frame. */
+static int RenderStatsFileRefs = 0;
+
+static void WriteRenderStatsFile(const char *fmt, ...) SDL_PRINTF_VARARG_FUNC(1);
+static void WriteRenderStatsFile(const char *fmt, ...)
+{
+    char buf[512];
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = SDL3_vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+
+    if (len > 0) {
+        SDL3_WriteIO(RenderStatsFile, buf, SDL_min((size_t)len, sizeof(buf) - 1));
+    }
+}
+
+static SDL2_RenderStats *CreateRenderStats(void)
+{
+    SDL2_RenderStats *stats;
+    const char *hint;
+
+    if (!SDL3_GetHintBoolean("SDL2COMPAT_RENDER_STATS", false)) {
+        return NULL;
+    }
+
+    stats = (SDL2_RenderStats *)SDL3_calloc(1, sizeof(*stats));
+    if (!stats) {
+        return NULL;
+    }
+    stats->id = RenderStatsNextId++;
+
+    stats->log_interval = 60;
+    hint = SDL3_GetHint("SDL2COMPAT_RENDER_STATS_INTERVAL");
+    if (hint) {
+        stats->log_interval = SDL_max(SDL3_atoi(hint), 0);
+    }
+
+    hint = SDL3_GetHint("SDL2COMPAT_RENDER_STATS_FILE");
+    if (hint && *hint) {
+        if (!RenderStatsFile) {
+            RenderStatsFile = SDL3_IOFromFile(hint, "w");
+            if (RenderStatsFile) {
+                int i;
+                WriteRenderStatsFile("renderer,frame");
+                for (i = 0; i < SDL2_RENDER_STATS_NUM_CALLS; ++i) {
+                    WriteRenderStatsFile(",%s", RenderStatsCallNames[i]);
+                }
+                WriteRenderStatsFile(",vertices,flushes,texture_creates,texture_updates,texture_update_bytes,texture_locks,texture_lock_bytes,target_switches,readbacks,readback_bytes\n");
+            } else {
+                SDL3_Log("sdl2-compat: couldn't open render stats file '%s': %s", hint, SDL3_GetError());
+            }
+        }
+        if (RenderStatsFile) {
+            ++RenderStatsFileRefs;
+            stats->csv = true;
+        }
+    }
+
+    WantRenderStats = true;
+    return stats;
+}
+
+static void DestroyRenderStats(SDL2_RenderStats *stats)
+{
+    if (stats->csv && --RenderStatsFileRefs == 0) {
+        SDL3_CloseIO(RenderStatsFile);
+        RenderStatsFile = NULL;
+    }
+    SDL3_free(stats);
+}
+
+static void AddRenderFrameStats(SDL2_RenderFrameStats *dst, const SDL2_RenderFrameStats *src)
+{
+    Uint64 *d = (Uint64 *)dst;
+    const Uint64 *s = (const Uint64 *)src;
+    size_t i;
+
+    for (i = 0; i < sizeof(*dst) / sizeof(Uint64); ++i) {
+        d[i] += s[i];
+    }
+}
+
+static void LogRenderStats(const SDL2_RenderStats *stats)
+{
+    const SDL2_RenderFrameStats *frames = &stats->interval;
+    char calls[256];
+    size_t len = 0;
+    Uint64 total = 0;
+    int i;
+
+    calls[0] = '\0';
+    for (i = 0; i < SDL2_RENDER_STATS_NUM_CALLS; ++i) {
+        if (frames->calls[i] && len < sizeof(calls)) {
+            len += SDL3_snprintf(calls + len, sizeof(calls) - len, "%s%s %" SDL_PRIu64, len ? ", " : "", RenderStatsCallNames[i], frames->calls[i]);
+        }
+        total += frames->calls[i];
+    }
+
+    SDL3_Log("sdl2-compat: renderer %d, frames %" SDL_PRIu64 "-%" SDL_PRIu64 ": %" SDL_PRIu64 " draw calls (%s), %" SDL_PRIu64 " vertices, %" SDL_PRIu64 " flushes",
+             stats->id, stats->frame - stats->interval_frames + 1, stats->frame, total, calls, frames->vertices, frames->flushes);
+    SDL3_Log("sdl2-compat: renderer %d: %" SDL_PRIu64 " texture creates, %" SDL_PRIu64 " updates (%" SDL_PRIu64 " bytes), %" SDL_PRIu64 " locks (%" SDL_PRIu64 " bytes), %" SDL_PRIu64 " target switches, %" SDL_PRIu64 " readbacks (%" SDL_PRIu64 " bytes)",
+             stats->id, frames->texture_creates, frames->texture_updates, frames->texture_update_bytes, frames->texture_locks, frames->texture_lock_bytes,
+             frames->target_switches, frames->readbacks, frames->readback_bytes);
+}
+
+static void EndRenderStatsFrame(SDL2_RenderStats *stats)
+{
+    const SDL2_RenderFrameStats *frame = &stats->current;
+
+    ++stats->frame;
+
+    if (stats->csv) {
+        int i;
+        WriteRenderStatsFile("%d,%" SDL_PRIu64, stats->id, stats->frame);
+        for (i = 0; i < SDL2_RENDER_STATS_NUM_CALLS; ++i) {
+            WriteRenderStatsFile(",%" SDL_PRIu64, frame->calls[i]);
+        }
+        WriteRenderStatsFile(",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 ",%" SDL_PRIu64 "\n",
+                             frame->vertices, frame->flushes, frame->texture_creates, frame->texture_updates, frame->texture_update_bytes,
+                             frame->texture_locks, frame->texture_lock_bytes, frame->target_switches, frame->readbacks, frame->readback_bytes);
+    }
+
+    if (stats->log_interval > 0) {
+        AddRenderFrameStats(&stats->interval, frame);
+        if (++stats->interval_frames == stats->log_interval) {
+            LogRenderStats(stats);
+            SDL3_zero(stats->interval);
+            stats->interval_frames = 0;
+        }
+    }
+
+    SDL3_zero(stats->current);
+}
+
+/* Per-renderer sdl2-compat state, reached through a single pointer property. */
+#define SDL2_MAX_QUEUED_TEXTURES 32
+
+typedef struct SDL2_RendererState
+{
+    bool batching;
+
+    /* Textures used since the last flush we know about, so SDL_GL_BindTexture() only flushes when it has to.
+       This is only tracked while batching; otherwise every draw is flushed right away. */
+    SDL_Texture *queued_textures[SDL2_MAX_QUEUED_TEXTURES];
+    int num_queued_textures;  /* more than SDL2_MAX_QUEUED_TEXTURES means we lost track. */
+
+    SDL2_RenderStats *stats;  /* NULL unless SDL2COMPAT_RENDER_STATS is enabled. */
+
+    /* While batching, consecutive SDL_RenderCopy() calls with the same texture are collected here and
+       submitted as one SDL3_RenderGeometryRaw() call. Anything that could change how they draw, or that
+       draws after them, submits them first. */
+    bool batch_sprites;
+    SDL_Texture *sprite_texture;  /* NULL if we aren't collecting sprites. */
+    float sprite_texture_w;
+    float sprite_texture_h;
+    SDL_FColor sprite_color;      /* sprite_texture's color and alpha mod. */
+    SDL_Vertex *sprite_vertices;  /* 4 per sprite, allocated on first use. */
+    Uint16 *sprite_indices;       /* 6 per sprite, always the same pattern. */
+    int num_sprites;
+    bool sprite_batch_failed;     /* SDL3 rejected a submitted batch; the next flush or present reports it. */
+    char sprite_batch_error[256]; /* SDL3's error from then, since other calls may have replaced it since. */
+} SDL2_RendererState;
+
+#define SDL2_MAX_BATCHED_SPRITES 256  /* keeps the indices in a Uint16. */
+
+static bool WantSpriteBatching = false;  /* true once any renderer batches sprites. */
+
+static void SDLCALL CleanupRendererState(void *userdata, void *value)
+{
+    SDL2_RendererState *state = (SDL2_RendererState *)value;
+    if (state->stats) {
+        DestroyRenderStats(state->stats);
+    }
+    SDL3_free(state->sprite_vertices);
+    SDL3_free(state->sprite_indices);
+    SDL3_free(state);
+}
+
+static SDL2_RendererState *CreateRendererState(SDL_PropertiesID props, bool batching)
+{
+    SDL2_RendererState *state = (SDL2_RendererState *)SDL3_calloc(1, sizeof(*state));
+    if (!state) {
+        return NULL;
+    }
+    state->batching = batching;
+    state->batch_sprites = batching && SDL3_GetHintBoolean("SDL2COMPAT_SPRITE_BATCHING", false);
+    state->stats = CreateRenderStats();
+    if (state->batch_sprites) {
+        WantSpriteBatching = true;
+    }
+
+    /* the cleanup callback frees state if this fails. */
+    if (!SDL3_SetPointerPropertyWithCleanup(props, PROP_RENDERER_STATE_POINTER, state, CleanupRendererState, NULL)) {
+        return NULL;
+    }
+    return state;
+}
+
+static SDL2_RendererState *GetRendererState(SDL_Renderer *renderer)
+{
+    const SDL_PropertiesID props = SDL3_GetRendererProperties(renderer);
+    SDL2_RendererState *state;
+
+    if (!props) {
+        return NULL;
+    }
+
+    state = (SDL2_RendererState *)SDL3_GetPointerProperty(props, PROP_RENDERER_STATE_POINTER, NULL);
+    if (!state) {
+        /* not created through SDL_CreateRenderer(), like software renderers. */
+        state = CreateRendererState(props, false);
+    }
+    return state;
+}
+
+static void NoteTextureQueued(SDL2_RendererState *state, SDL_Texture *texture)
+{
+    int i;
+
+    if (state->num_queued_textures > SDL2_MAX_QUEUED_TEXTURES) {
+        return;  /* already lost track. */
+    }
+
+    /* most draws reuse the last texture, so check from the end. */
+    for (i = state->num_queued_textures - 1; i >= 0; --i) {
+        if (state->queued_textures[i] == texture) {
+            return;
+        }
+    }
+
+    if (state->num_queued_textures < SDL2_MAX_QUEUED_TEXTURES) {
+        state->queued_textures[state->num_queued_textures] = texture;
+    }
+    ++state->num_queued_textures;
+}
+
+static bool IsTextureQueued(const SDL2_RendererState *state, SDL_Texture *texture)
+{
+    int i;
+
+    if (state->num_queued_textures > SDL2_MAX_QUEUED_TEXTURES) {
+        return true;  /* assume the worst. */
+    }
+
+    for (i = 0; i < state->num_queued_textures; ++i) {
+        if (state->queued_textures[i] == texture) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void ResetQueuedTextures(SDL_Renderer *renderer, SDL2_RendererState *state)
+{
+    SDL_Texture *target;
+
+    state->num_queued_textures = 0;
+
+    /* anything drawn from here on lands in the current target. */
+    target = SDL3_GetRenderTarget(renderer);
+    if (target) {
+        NoteTextureQueued(state, target);
+    }
+}
+
+/* The copies already returned 0, so if SDL3 rejects them this is remembered for SDL_RenderFlush(). */
+static int SubmitSpriteBatch(SDL_Renderer *renderer, SDL2_RendererState *state)
+{
+    int retval = 0;
+    if (state->num_sprites > 0) {
+        const SDL_Vertex *v = state->sprite_vertices;
+        if (!SDL3_RenderGeometryRaw(renderer, state->sprite_texture, &v->position.x, sizeof(*v), &v->color, sizeof(*v), &v->tex_coord.x, sizeof(*v),
+                                    state->num_sprites * 4, state->sprite_indices, state->num_sprites * 6, sizeof(*state->sprite_indices))) {
+            state->sprite_batch_failed = true;
+            SDL3_strlcpy(state->sprite_batch_error, SDL3_GetError(), sizeof(state->sprite_batch_error));
+            retval = -1;
+        }
+        state->num_sprites = 0;
+    }
+    return retval;
+}
+
+static int EndSpriteBatch(SDL_Renderer *renderer, SDL2_RendererState *state)
+{
+    const int retval = SubmitSpriteBatch(renderer, state);
+    state->sprite_texture = NULL;
+    return retval;
+}
+
+static void SubmitSprites(SDL_Renderer *renderer)
+{
+    if (WantSpriteBatching && renderer) {
+        SDL2_RendererState *state = GetRendererState(renderer);
+        if (state && state->sprite_texture) {
+            EndSpriteBatch(renderer, state);
+        }
+    }
+}
+
+/* Submit pending sprites if changing texture would change what they draw, or what they draw over. */
+static void SubmitTextureSprites(SDL_Texture *texture)
+{
+    if (WantSpriteBatching && texture) {
+        SDL_Renderer *renderer = SDL3_GetRendererFromTexture(texture);
+        SDL2_RendererState *state = renderer ? GetRendererState(renderer) : NULL;
+        if (state && state->sprite_texture && (state->sprite_texture == texture || SDL3_GetRenderTarget(renderer) == texture)) {
+            EndSpriteBatch(renderer, state);
+        }
+    }
+}
+
+static bool StartSpriteBatch(SDL2_RendererState *state, SDL_Texture *texture)
+{
+    const SDL2_TextureInfo *info;
+    Uint8 r, g, b, a;
+
+    info = GetTextureInfo(texture);
+    if (!info || SDL_ISPIXELFORMAT_FOURCC(info->format)) {
+        return false;
+    }
+
+    /* the mods are constant for the whole batch, changing them submits it. */
+    if (!SDL3_GetTextureColorMod(texture, &r, &g, &b) || !SDL3_GetTextureAlphaMod(texture, &a)) {
+        return false;
+    }
+
+    if (!state->sprite_vertices) {
+        int i;
+        state->sprite_vertices = (SDL_Vertex *)SDL3_malloc(SDL2_MAX_BATCHED_SPRITES * 4 * sizeof(*state->sprite_vertices));
+        state->sprite_indices = (Uint16 *)SDL3_malloc(SDL2_MAX_BATCHED_SPRITES * 6 * sizeof(*state->sprite_indices));
+        if (!state->sprite_vertices || !state->sprite_indices) {
+            SDL3_free(state->sprite_vertices);
+            SDL3_free(state->sprite_indices);
+            state->sprite_vertices = NULL;
+            state->sprite_indices = NULL;
+            return false;
+        }
+
+        /* the same triangles SDL3 uses for SDL_RenderTexture(). */
+        for (i = 0; i < SDL2_MAX_BATCHED_SPRITES; ++i) {
+            Uint16 *idx = &state->sprite_indices[i * 6];
+            const Uint16 first = (Uint16)(i * 4);
+            idx[0] = first;
+            idx[1] = first + 1;
+            idx[2] = first + 2;
+            idx[3] = first;
+            idx[4] = first + 2;
+            idx[5] = first + 3;
+        }
+    }
+
+    state->sprite_texture = texture;
+    state->sprite_texture_w = (float)info->w;
+    state->sprite_texture_h = (float)info->h;
+    state->sprite_color.r = r / 255.0f;
+    state->sprite_color.g = g / 255.0f;
+    state->sprite_color.b = b / 255.0f;
+    state->sprite_color.a = a / 255.0f;
+    NoteTextureQueued(state, texture);
+    return true;
+}
+
+/* Returns false if the copy should go to SDL3_RenderTexture() instead; nothing is pending then. */
+static bool BatchRenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL2_RendererState *state;
+    float srcx, srcy, srcw, srch;
+    float minu, maxu, minv, maxv;
+    SDL_Vertex *v;
+    int i;
+
+    if (!WantSpriteBatching) {
+        return false;
+    }
+
+    state = GetRendererState(renderer);
+    if (!state || !state->batch_sprites) {
+        return false;
+    }
+
+    /* A batched copy returns 0 before SDL3 sees it, so anything SDL3_RenderTexture() would reject goes there
+       instead, to be reported right away. A NULL dstrect fills the current view, which might change before we submit. */
+    if (!texture || !dstrect || SDL3_GetRendererFromTexture(texture) != renderer || SDL3_GetRenderTarget(renderer) == texture) {
+        EndSpriteBatch(renderer, state);
+        return false;
+    }
+
+    if (texture != state->sprite_texture) {
+        EndSpriteBatch(renderer, state);
+        if (!StartSpriteBatch(state, texture)) {
+            return false;
+        }
+    } else if (state->num_sprites == SDL2_MAX_BATCHED_SPRITES) {
+        SubmitSpriteBatch(renderer, state);
+    }
+
+    if (state->stats) {
+        ++state->stats->current.calls[SDL2_RENDER_STATS_COPY];
+        state->stats->current.vertices += 4;
+    }
+
+    /* Clip srcrect to the texture, but leave dstrect alone, exactly like SDL3_RenderTexture(). */
+    srcx = 0.0f;
+    srcy = 0.0f;
+    srcw = state->sprite_texture_w;
+    srch = state->sprite_texture_h;
+    if (srcrect) {
+        const float maxx = SDL_min(srcrect->x + srcrect->w, srcw);
+        const float maxy = SDL_min(srcrect->y + srcrect->h, srch);
+        if (srcrect->w < 0.0f || srcrect->h < 0.0f) {
+            return true;
+        }
+        srcx = SDL_max(srcrect->x, 0.0f);
+        srcy = SDL_max(srcrect->y, 0.0f);
+        srcw = maxx - srcx;
+        srch = maxy - srcy;
+        if (srcw < 0.0f || srch < 0.0f) {
+            return true;  /* nothing to draw. */
+        }
+    }
+
+    minu = srcx / state->sprite_texture_w;
+    maxu = (srcx + srcw) / state->sprite_texture_w;
+    minv = srcy / state->sprite_texture_h;
+    maxv = (srcy + srch) / state->sprite_texture_h;
+
+    v = &state->sprite_vertices[state->num_sprites * 4];
+    v[0].position.x = dstrect->x;
+    v[0].position.y = dstrect->y;
+    v[0].tex_coord.x = minu;
+    v[0].tex_coord.y = minv;
+    v[1].position.x = dstrect->x + dstrect->w;
+    v[1].position.y = dstrect->y;
+    v[1].tex_coord.x = maxu;
+    v[1].tex_coord.y = minv;
+    v[2].position.x = dstrect->x + dstrect->w;
+    v[2].position.y = dstrect->y + dstrect->h;
+    v[2].tex_coord.x = maxu;
+    v[2].tex_coord.y = maxv;
+    v[3].position.x = dstrect->x;
+    v[3].position.y = dstrect->y + dstrect->h;
+    v[3].tex_coord.x = minu;
+    v[3].tex_coord.y = maxv;
+    for (i = 0; i < 4; ++i) {
+        v[i].color = state->sprite_color;
+    }
+    ++state->num_sprites;
+    return true;
+}
+
+/* Returns -1 with the error set if SDL3 rejected sprites we already said were drawn, and forgets about it. */
+static int ReportSpriteBatchError(SDL2_RendererState *state)
+{
+    if (state && state->sprite_batch_failed) {
+        state->sprite_batch_failed = false;
+        SDL3_SetError("%s", state->sprite_batch_error);
+        return -1;
+    }
+    return 0;
+}
+
+static int FlushRenderer(SDL_Renderer *renderer, SDL2_RendererState *state)
 {
-    const SDL_PropertiesID props = SDL3_GetRendererProperties(renderer);
-    if (!SDL3_GetBooleanProperty(props, PROP_RENDERER_BATCHING, false)) {
-        return SDL3_FlushRenderer(renderer) ? 0 : -1;
+    bool batch_failed;
+
+    if (state && state->sprite_texture) {
+        EndSpriteBatch(renderer, state);
+    }
+    batch_failed = state && state->sprite_batch_failed;
+    if (state && state->batching) {
+        ResetQueuedTextures(renderer, state);
+    }
+    if (state && state->stats) {
+        ++state->stats->current.flushes;
+    }
+    if (batch_failed) {
+        SDL3_FlushRenderer(renderer);
+        return ReportSpriteBatchError(state);  /* after the flush, so its error isn't the one the app sees. */
+    }
+    return SDL3_FlushRenderer(renderer) ? 0 : -1;
+}
+
+static int FlushRendererIfNotBatchingTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL2_RendererState *state = GetRendererState(renderer);
+    if (!state || !state->batching) {
+        return FlushRenderer(renderer, state);
+    }
+    if (texture) {
+        NoteTextureQueued(state, texture);
     }
     return 0;
 }
 
+static int FlushRendererIfNotBatching(SDL_Renderer *renderer)
+{
+    return FlushRendererIfNotBatchingTexture(renderer, NULL);
+}
+
+static SDL2_RenderFrameStats *GetRenderFrameStats(SDL_Renderer *renderer)
+{
+    SDL2_RendererState *state;
+
+    if (!WantRenderStats || !renderer) {
+        return NULL;
+    }
+
+    state = GetRendererState(renderer);
+    return (state && state->stats) ? &state->stats->current : NULL;
+}
+
+static SDL2_RenderFrameStats *GetTextureRenderFrameStats(SDL_Texture *texture)
+{
+    if (!WantRenderStats) {
+        return NULL;
+    }
+    return GetRenderFrameStats(SDL3_GetRendererFromTexture(texture));
+}
+
+/* roughly how many bytes an update of rect (or the whole texture) uploads. */
+static Uint64 GetTextureUploadBytes(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    const SDL2_TextureInfo *info = GetTextureInfo(texture);
+    Uint64 pixels;
+
+    if (!info) {
+        return 0;
+    }
+
+    pixels = rect ? ((Uint64)rect->w * rect->h) : ((Uint64)info->w * info->h);
+    if (SDL_ISPIXELFORMAT_FOURCC(info->format)) {
+        return pixels * 2;  /* YUV formats are 12 or 16 bits per pixel. */
+    }
+    return pixels * SDL_BYTESPERPIXEL(info->format);
+}
+
+/* Every SDL2 draw call ends up here once SDL3 accepted it. */
+static int FinishRenderCall(SDL_Renderer *renderer, SDL_Texture *texture, SDL2_RenderStatsCall call, int vertices)
+{
+    SDL2_RenderFrameStats *stats = GetRenderFrameStats(renderer);
+    if (stats) {
+        ++stats->calls[call];
+        stats->vertices += vertices;
+    }
+    return FlushRendererIfNotBatchingTexture(renderer, texture);
+}
+
 /* Second parameter changed from an index to a string in SDL3. */
 SDL_DECLSPEC SDL_Renderer *SDLCALL
 SDL_CreateRenderer(SDL_Window *window, int idx, Uint32 flags)
@@ -5977,8 +8812,9 @@ SDL_CreateRenderer(SDL_Window *window, int idx, Uint32 flags)
     renderer = SDL3_CreateRenderer(window, name);
     props = SDL3_GetRendererProperties(renderer);
     if (props) {
-        SDL3_SetBooleanProperty(props, PROP_RENDERER_BATCHING, SDL3_GetHintBoolean("SDL_RENDER_BATCHING", (name == NULL)));
+        CreateRendererState(props, SDL3_GetHintBoolean("SDL_RENDER_BATCHING", (name == NULL)));
         SDL3_SetBooleanProperty(props, PROP_RENDERER_RELATIVE_SCALING, SDL3_GetHintBoolean("SDL_MOUSE_RELATIVE_SCALING", true));
+        CreateTexturePool(props);
     }
     if (flags & SDL2_RENDERER_PRESENTVSYNC) {
         SDL3_SetRenderVSync(renderer, 1);
@@ -6106,6 +8942,8 @@ SDL_RenderSetLogicalSize(SDL_Renderer *renderer, int w, int h)
         }
     }
 
+    SubmitSprites(renderer);
+
     /* SDL2 overwrites the user set scale when setting the logical size, while SDL3 tracks it separately.
      * Set to 1.0 to avoid double scaling within SDL3.
      */
@@ -6158,6 +8996,7 @@ SDL_RenderSetViewport(SDL_Renderer *renderer, const SDL_Rect *rect)
         rect = &adjusted_viewport;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_SetRenderViewport(renderer, rect) ? 0 : -1;
     return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
 }
@@ -6165,17 +9004,34 @@ SDL_RenderSetViewport(SDL_Renderer *renderer, const SDL_Rect *rect)
 SDL_DECLSPEC int SDLCALL
 SDL_RenderSetClipRect(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
-    const int retval = SDL3_SetRenderClipRect(renderer, rect) ? 0 : -1;
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_SetRenderClipRect(renderer, rect) ? 0 : -1;
     return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
 }
 
+SDL_DECLSPEC int SDLCALL
+SDL_RenderSetScale(SDL_Renderer *renderer, float scaleX, float scaleY)
+{
+    SubmitSprites(renderer);
+    return SDL3_SetRenderScale(renderer, scaleX, scaleY) ? 0 : -1;
+}
+
 SDL_DECLSPEC int SDLCALL
 SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    SDL2_RenderFrameStats *stats;
+
+    SubmitSprites(renderer);
     if (!SDL3_SetRenderTarget(renderer, texture)) {
         return -1;
     }
 
+    stats = GetRenderFrameStats(renderer);
+    if (stats) {
+        ++stats->target_switches;
+    }
+
     /* SDL2 reset the viewport, scale, and logical presentation for textures.
         If moving from the backbuffer to a texture, it makes a backup of that
         state and restores it when moving back to the backbuffer...but SDL3
@@ -6197,14 +9053,16 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         SDL3_SetRenderLogicalPresentation(renderer, viewport.w, viewport.h, SDL_LOGICAL_PRESENTATION_DISABLED);
     }
 
-    return FlushRendererIfNotBatching(renderer);
+    return FlushRendererIfNotBatchingTexture(renderer, texture);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderClear(SDL_Renderer *renderer)
 {
-    const int retval = SDL3_RenderClear(renderer) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderClear(renderer) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_CLEAR, 0);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6214,8 +9072,9 @@ SDL_RenderDrawPointF(SDL_Renderer *renderer, float x, float y)
     SDL_FPoint fpoint;
     fpoint.x = x;
     fpoint.y = y;
+    SubmitSprites(renderer);
     retval = SDL3_RenderPoints(renderer, &fpoint, 1) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_POINTS, 1);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6248,18 +9107,21 @@ SDL_RenderDrawPoints(SDL_Renderer *renderer,
         fpoints[i].y = (float)points[i].y;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderPoints(renderer, fpoints, count) ? 0 : -1;
 
     SDL3_small_free(fpoints, isstack);
 
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_POINTS, count);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderDrawPointsF(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
 {
-    const int retval = SDL3_RenderPoints(renderer, points, count) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderPoints(renderer, points, count) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_POINTS, count);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6271,8 +9133,9 @@ SDL_RenderDrawLineF(SDL_Renderer *renderer, float x1, float y1, float x2, float
     points[0].y = (float)y1;
     points[1].x = (float)x2;
     points[1].y = (float)y2;
+    SubmitSprites(renderer);
     retval = SDL3_RenderLines(renderer, points, 2) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_LINES, 2);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6307,18 +9170,21 @@ SDL_RenderDrawLines(SDL_Renderer *renderer, const SDL_Point *points, int count)
         fpoints[i].y = (float)points[i].y;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderLines(renderer, fpoints, count) ? 0 : -1;
 
     SDL3_small_free(fpoints, isstack);
 
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_LINES, count);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderDrawLinesF(SDL_Renderer *renderer, const SDL_FPoint *points, int count)
 {
-    const int retval = SDL3_RenderLines(renderer, points, count) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderLines(renderer, points, count) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_LINES, count);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6336,8 +9202,9 @@ SDL_RenderDrawRect(SDL_Renderer *renderer, const SDL_Rect *rect)
         prect = &frect;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderRect(renderer, prect) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_RECTS, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6368,25 +9235,30 @@ SDL_RenderDrawRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count)
         frects[i].h = (float)rects[i].h;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderRects(renderer, frects, count) ? 0 : -1;
 
     SDL3_small_free(frects, isstack);
 
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_RECTS, 4 * count);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderDrawRectF(SDL_Renderer *renderer, const SDL_FRect *rect)
 {
-    const int retval = SDL3_RenderRect(renderer, rect) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderRect(renderer, rect) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_RECTS, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderDrawRectsF(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 {
-    const int retval = SDL3_RenderRects(renderer, rects, count) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderRects(renderer, rects, count) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_RECTS, 4 * count);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6394,6 +9266,7 @@ SDL_RenderFillRect(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
     int retval;
     SDL_FRect frect;
+    SubmitSprites(renderer);
     if (rect) {
         frect.x = (float)rect->x;
         frect.y = (float)rect->y;
@@ -6403,7 +9276,7 @@ SDL_RenderFillRect(SDL_Renderer *renderer, const SDL_Rect *rect)
     } else {
         retval = SDL3_RenderFillRect(renderer, NULL) ? 0 : -1;
     }
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_FILL_RECTS, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6434,25 +9307,30 @@ SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count)
         frects[i].h = (float)rects[i].h;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderFillRects(renderer, frects, count) ? 0 : -1;
 
     SDL3_small_free(frects, isstack);
 
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_FILL_RECTS, 4 * count);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderFillRectF(SDL_Renderer *renderer, const SDL_FRect *rect)
 {
-    const int retval = SDL3_RenderFillRect(renderer, rect) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderFillRect(renderer, rect) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_FILL_RECTS, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_RenderFillRectsF(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 {
-    const int retval = SDL3_RenderFillRects(renderer, rects, count) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    int retval;
+    SubmitSprites(renderer);
+    retval = SDL3_RenderFillRects(renderer, rects, count) ? 0 : -1;
+    return retval < 0 ? retval : FinishRenderCall(renderer, NULL, SDL2_RENDER_STATS_FILL_RECTS, 4 * count);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6481,8 +9359,11 @@ SDL_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *src
         dstfrect.h = (float)dstrect->h;
         pdstfrect = &dstfrect;
     }
+    if (BatchRenderCopy(renderer, texture, psrcfrect, pdstfrect)) {
+        return 0;
+    }
     retval = SDL3_RenderTexture(renderer, texture, psrcfrect, pdstfrect) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, texture, SDL2_RENDER_STATS_COPY, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6502,8 +9383,11 @@ SDL_RenderCopyF(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *sr
             return 0;
         }
     }
+    if (BatchRenderCopy(renderer, texture, psrcfrect, dstrect)) {
+        return 0;
+    }
     retval = SDL3_RenderTexture(renderer, texture, psrcfrect, dstrect) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, texture, SDL2_RENDER_STATS_COPY, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6545,8 +9429,9 @@ SDL_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
         pfcenter = &fcenter;
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderTextureRotated(renderer, texture, psrcfrect, pdstfrect, angle, pfcenter, flip) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, texture, SDL2_RENDER_STATS_COPY_EX, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6570,8 +9455,9 @@ SDL_RenderCopyExF(SDL_Renderer *renderer, SDL_Texture *texture,
         }
     }
 
+    SubmitSprites(renderer);
     retval = SDL3_RenderTextureRotated(renderer, texture, psrcfrect, dstrect, angle, center, flip) ? 0 : -1;
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, texture, SDL2_RENDER_STATS_COPY_EX, 4);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6622,9 +9508,10 @@ SDL_RenderGeometryRaw(SDL_Renderer *renderer, SDL_Texture *texture, const float
     }
 
     color_stride = sizeof(SDL_FColor);
+    SubmitSprites(renderer);
     retval = SDL3_RenderGeometryRaw(renderer, texture, xy, xy_stride, color3, color_stride, uv, uv_stride, num_vertices, indices, num_indices, size_indices) ? 0 : -1;
     SDL3_small_free(color3, isstack);
-    return retval < 0 ? retval : FlushRendererIfNotBatching(renderer);
+    return retval < 0 ? retval : FinishRenderCall(renderer, texture, SDL2_RENDER_STATS_GEOMETRY, num_vertices);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -6632,16 +9519,26 @@ SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format
 {
     int result = -1;
     SDL_Texture* target;
+    SDL2_RenderFrameStats *stats;
+    SDL_Surface *surface;
 
-    SDL_Surface *surface = SDL3_RenderReadPixels(renderer, rect);
+    SubmitSprites(renderer);
+    surface = SDL3_RenderReadPixels(renderer, rect);
     if (!surface) {
         return -1;
     }
 
+    stats = GetRenderFrameStats(renderer);
+    if (stats) {
+        ++stats->readbacks;
+        stats->readback_bytes += (Uint64)surface->pitch * surface->h;
+    }
+
     if (!format) {
         target = SDL3_GetRenderTarget(renderer);
         if (target) {
-            format = (Uint32)SDL3_GetNumberProperty(SDL3_GetTextureProperties(target), SDL_PROP_TEXTURE_FORMAT_NUMBER, 0);
+            const SDL2_TextureInfo *info = GetTextureInfo(target);
+            format = info ? info->format : SDL_PIXELFORMAT_UNKNOWN;
         } else {
             format = SDL3_GetWindowPixelFormat((SDL_Window *)SDL3_GetPointerProperty(SDL3_GetRendererProperties(renderer), SDL_PROP_RENDERER_WINDOW_POINTER, NULL));
         }
@@ -6659,7 +9556,33 @@ SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 format
 SDL_DECLSPEC void SDLCALL
 SDL_RenderPresent(SDL_Renderer *renderer)
 {
+    SDL2_RendererState *state = GetRendererState(renderer);
+    if (state && state->sprite_texture) {
+        EndSpriteBatch(renderer, state);
+    }
+    if (state && state->batching) {
+        ResetQueuedTextures(renderer, state);  /* presenting flushes everything. */
+    }
+    if (state && state->stats) {
+        EndRenderStatsFrame(state->stats);
+    }
     SDL3_RenderPresent(renderer);
+
+    /* SDL2's SDL_RenderPresent() returns nothing, so a rejected batch can only be reported through SDL_GetError(). */
+    ReportSpriteBatchError(state);
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_RenderFlush(SDL_Renderer *renderer)
+{
+    return FlushRenderer(renderer, GetRendererState(renderer));
+}
+
+SDL_DECLSPEC void * SDLCALL
+SDL_RenderGetMetalCommandEncoder(SDL_Renderer *renderer)
+{
+    SubmitSprites(renderer);  /* the app is about to draw, so get our sprites in first. */
+    return SDL3_GetRenderMetalCommandEncoder(renderer);
 }
 
 static SDL_ScaleMode SDL_GetScaleMode(void)
@@ -6676,20 +9599,197 @@ static SDL_ScaleMode SDL_GetScaleMode(void)
     }
 }
 
+/* Opt-in pool of recently destroyed textures. Apps that destroy and recreate a texture with the
+   same format and size, sometimes every frame, get the old one back from SDL_CreateTexture(). */
+typedef struct SDL2_TexturePoolEntry
+{
+    SDL_Texture *texture;
+    const SDL2_TextureInfo *info;
+    size_t bytes;
+} SDL2_TexturePoolEntry;
+
+typedef struct SDL2_TexturePool
+{
+    SDL2_TexturePoolEntry *entries;  /* oldest first. */
+    int num_entries;
+    int max_entries;
+    size_t bytes_held;
+    size_t max_bytes;
+    Uint64 hits;
+    Uint64 misses;
+} SDL2_TexturePool;
+
+static void SDLCALL CleanupTexturePool(void *userdata, void *value)
+{
+    /* The renderer destroys all its textures, including pooled ones, so we just free our bookkeeping here. */
+    SDL2_TexturePool *pool = (SDL2_TexturePool *)value;
+    if (WantDebugLogging) {
+        SDL3_Log("sdl2-compat: texture pool: %" SDL_PRIu64 " hits, %" SDL_PRIu64 " misses, %" SDL_PRIu64 " bytes held",
+                 pool->hits, pool->misses, (Uint64)pool->bytes_held);
+    }
+    SDL3_free(pool->entries);
+    SDL3_free(pool);
+}
+
+static void CreateTexturePool(SDL_PropertiesID props)
+{
+    SDL2_TexturePool *pool;
+    const char *hint;
+    int megabytes = 64;
+
+    if (!SDL3_GetHintBoolean("SDL2COMPAT_TEXTURE_POOL", false)) {
+        return;
+    }
+
+    hint = SDL3_GetHint("SDL2COMPAT_TEXTURE_POOL_MEMORY");
+    if (hint && SDL3_atoi(hint) > 0) {
+        megabytes = SDL3_atoi(hint);
+    }
+
+    pool = (SDL2_TexturePool *)SDL3_calloc(1, sizeof(*pool));
+    if (pool) {
+        pool->max_bytes = (size_t)megabytes * 1024 * 1024;
+        SDL3_SetPointerPropertyWithCleanup(props, PROP_RENDERER_TEXTURE_POOL_POINTER, pool, CleanupTexturePool, NULL);
+    }
+}
+
+static SDL2_TexturePool *GetTexturePool(SDL_Renderer *renderer)
+{
+    return (SDL2_TexturePool *)SDL3_GetPointerProperty(SDL3_GetRendererProperties(renderer), PROP_RENDERER_TEXTURE_POOL_POINTER, NULL);
+}
+
+static size_t GetTextureMemoryEstimate(const SDL2_TextureInfo *info)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(info->format)) {
+        return (size_t)info->w * info->h * 2;  /* YUV formats are 12 or 16 bits per pixel. */
+    }
+    return (size_t)info->w * info->h * SDL_BYTESPERPIXEL(info->format);
+}
+
+static void RemoveTexturePoolEntry(SDL2_TexturePool *pool, int idx)
+{
+    pool->bytes_held -= pool->entries[idx].bytes;
+    --pool->num_entries;
+    SDL3_memmove(&pool->entries[idx], &pool->entries[idx + 1], (pool->num_entries - idx) * sizeof(*pool->entries));
+}
+
+static SDL_Texture *TakeTextureFromPool(SDL_Renderer *renderer, Uint32 format, int access, int w, int h, SDL_Colorspace colorspace)
+{
+    SDL2_TexturePool *pool = GetTexturePool(renderer);
+    int i;
+
+    if (!pool) {
+        return NULL;
+    }
+
+    /* most recently pooled first, it's the most likely to be wanted again. */
+    for (i = pool->num_entries - 1; i >= 0; --i) {
+        const SDL2_TextureInfo *info = pool->entries[i].info;
+        if (info->format == format && info->access == access && info->w == w && info->h == h && info->colorspace == colorspace) {
+            SDL_Texture *texture = pool->entries[i].texture;
+            RemoveTexturePoolEntry(pool, i);
+            ++pool->hits;
+            return texture;
+        }
+    }
+    ++pool->misses;
+    return NULL;
+}
+
+static bool ReturnTextureToPool(SDL_Renderer *renderer, SDL2_TexturePool *pool, SDL_Texture *texture)
+{
+    SDL2_TextureInfo *info = GetTextureInfo(texture);
+    size_t bytes;
+    int i;
+
+    if (!info) {
+        return false;
+    }
+
+    /* As far as the app is concerned, a pooled texture was already destroyed. */
+    for (i = 0; i < pool->num_entries; ++i) {
+        if (pool->entries[i].texture == texture) {
+            SDL3_InvalidParamError("texture");
+            return true;
+        }
+    }
+
+    bytes = GetTextureMemoryEstimate(info);
+    if (bytes > pool->max_bytes) {
+        return false;
+    }
+
+    if (pool->num_entries == pool->max_entries) {
+        const int max_entries = pool->max_entries ? pool->max_entries * 2 : 16;
+        void *ptr = SDL3_realloc(pool->entries, max_entries * sizeof(*pool->entries));
+        if (!ptr) {
+            return false;
+        }
+        pool->entries = (SDL2_TexturePoolEntry *)ptr;
+        pool->max_entries = max_entries;
+    }
+
+    /* SDL2 unlocked the texture and reset the render target when destroying it, so do that now. */
+    if (info->locked) {
+        SDL_UnlockTexture(texture);
+    }
+    if (SDL3_GetRenderTarget(renderer) == texture) {
+        SDL_SetRenderTarget(renderer, NULL);
+    }
+
+    while (pool->bytes_held + bytes > pool->max_bytes) {
+        SDL_Texture *oldest = pool->entries[0].texture;
+        RemoveTexturePoolEntry(pool, 0);
+        SDL3_DestroyTexture(oldest);
+    }
+
+    pool->entries[pool->num_entries].texture = texture;
+    pool->entries[pool->num_entries].info = info;
+    pool->entries[pool->num_entries].bytes = bytes;
+    ++pool->num_entries;
+    pool->bytes_held += bytes;
+    return true;
+}
+
 SDL_DECLSPEC SDL_Texture * SDLCALL
 SDL_CreateTexture(SDL_Renderer *renderer, Uint32 format, int access, int w, int h)
 {
-    SDL_Texture *texture;
-    SDL_PropertiesID props = SDL3_CreateProperties();
+    const SDL_Colorspace colorspace = GetColorspaceForFormatAndSize(format, w, h);
+    SDL_Texture *texture = TakeTextureFromPool(renderer, format, access, w, h, colorspace);
+    SDL2_RenderFrameStats *stats = GetRenderFrameStats(renderer);
+    SDL_PropertiesID props;
+
+    if (texture) {
+        /* reset everything the app could have changed, so it looks like a new texture. */
+        SDL2_TextureInfo *info = GetTextureInfo(texture);
+        SDL3_ClearProperty(SDL3_GetTextureProperties(texture), PROP_TEXTURE_USERDATA_POINTER);
+        SDL3_SetTextureColorMod(texture, 255, 255, 255);
+        SDL3_SetTextureAlphaMod(texture, 255);
+        SDL3_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+        SDL3_SetTextureScaleMode(texture, SDL_GetScaleMode());
+        if (info && !SDL3_GetTextureScaleMode(texture, &info->scale_mode)) {
+            info->scale_mode = SDL_SCALEMODE_LINEAR;
+        }
+        if (stats) {
+            ++stats->texture_creates;
+        }
+        return texture;
+    }
+
+    props = SDL3_CreateProperties();
     SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, format);
     SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, access);
     SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, w);
     SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, h);
-    SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, GetColorspaceForFormatAndSize(format, w, h));
+    SDL3_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_COLORSPACE_NUMBER, colorspace);
     texture = SDL3_CreateTextureWithProperties(renderer, props);
     if (texture) {
         SDL3_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
         SDL3_SetTextureScaleMode(texture, SDL_GetScaleMode());
+        CreateTextureInfo(texture, SDL3_GetTextureProperties(texture));
+        if (stats) {
+            ++stats->texture_creates;
+        }
     }
     SDL3_DestroyProperties(props);
     return texture;
@@ -6700,61 +9800,181 @@ SDL_CreateTextureFromSurface(SDL_Renderer *renderer, SDL2_Surface *surface)
 {
     SDL_Texture *texture = SDL3_CreateTextureFromSurface(renderer, Surface2to3(surface));
     if (texture) {
+        SDL2_RenderFrameStats *stats = GetRenderFrameStats(renderer);
         SDL3_SetTextureScaleMode(texture, SDL_GetScaleMode());
+        CreateTextureInfo(texture, SDL3_GetTextureProperties(texture));
+        if (stats) {
+            ++stats->texture_creates;
+            ++stats->texture_updates;
+            stats->texture_update_bytes += GetTextureUploadBytes(texture, NULL);
+        }
+    }
+    return texture;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_QueryTexture(SDL_Texture *texture, Uint32 *format, int *access, int *w, int *h)
+{
+    const SDL2_TextureInfo *info = GetTextureInfo(texture);
+    if (!info) {
+        return -1;
+    }
+
+    if (format) {
+        *format = info->format;
+    }
+    if (access) {
+        *access = info->access;
+    }
+    if (w) {
+        *w = info->w;
+    }
+    if (h) {
+        *h = info->h;
+    }
+    return 0;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_SetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode scaleMode)
+{
+    SDL2_TextureInfo *info = GetTextureInfo(texture);
+    SubmitTextureSprites(texture);
+    if (info) {
+        info->scale_mode = scaleMode;
+    }
+    if (scaleMode > SDL_SCALEMODE_LINEAR) {
+        scaleMode = SDL_SCALEMODE_LINEAR;
+    }
+    return SDL3_SetTextureScaleMode(texture, scaleMode) ? 0 : -1;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_GetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode *scaleMode)
+{
+    const SDL2_TextureInfo *info = GetTextureInfo(texture);
+    if (!info) {
+        return -1;
+    }
+    if (scaleMode) {
+        *scaleMode = info->scale_mode;
+    }
+    return 0;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect, void **pixels, int *pitch)
+{
+    SDL2_TextureInfo *info;
+    SDL2_RenderFrameStats *stats;
+
+    SubmitTextureSprites(texture);
+    if (!SDL3_LockTexture(texture, rect, pixels, pitch)) {
+        return -1;
+    }
+
+    info = GetTextureInfo(texture);
+    if (info) {
+        info->locked = true;
+    }
+
+    stats = GetTextureRenderFrameStats(texture);
+    if (stats) {
+        ++stats->texture_locks;
+        stats->texture_lock_bytes += GetTextureUploadBytes(texture, rect);
+    }
+    return 0;
+}
+
+SDL_DECLSPEC void SDLCALL
+SDL_UnlockTexture(SDL_Texture *texture)
+{
+    SDL2_TextureInfo *info = GetTextureInfo(texture);
+    if (info) {
+        info->locked = false;
+        if (info->lock_surface) {
+            info->lock_surface->map = NULL;  /* SDL3 destroys the locked surface when unlocking. */
+        }
+    }
+    SDL3_UnlockTexture(texture);
+}
+
+static void NoteTextureUpdate(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    SDL2_RenderFrameStats *stats = GetTextureRenderFrameStats(texture);
+    if (stats) {
+        ++stats->texture_updates;
+        stats->texture_update_bytes += GetTextureUploadBytes(texture, rect);
     }
-    return texture;
 }
 
 SDL_DECLSPEC int SDLCALL
-SDL_QueryTexture(SDL_Texture *texture, Uint32 *format, int *access, int *w, int *h)
+SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *pixels, int pitch)
 {
-    SDL_PropertiesID props = SDL3_GetTextureProperties(texture);
-    if (!props) {
+    SubmitTextureSprites(texture);
+    if (!SDL3_UpdateTexture(texture, rect, pixels, pitch)) {
         return -1;
     }
+    NoteTextureUpdate(texture, rect);
+    return 0;
+}
 
-    if (format) {
-        *format = (Uint32)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
-    }
-    if (access) {
-        *access = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_ACCESS_NUMBER, SDL_TEXTUREACCESS_STATIC);
-    }
-    if (w) {
-        *w = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_WIDTH_NUMBER, 0);
-    }
-    if (h) {
-        *h = (int)SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_HEIGHT_NUMBER, 0);
+SDL_DECLSPEC int SDLCALL
+SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect, const Uint8 *Yplane, int Ypitch, const Uint8 *Uplane, int Upitch, const Uint8 *Vplane, int Vpitch)
+{
+    SubmitTextureSprites(texture);
+    if (!SDL3_UpdateYUVTexture(texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch)) {
+        return -1;
     }
+    NoteTextureUpdate(texture, rect);
     return 0;
 }
 
 SDL_DECLSPEC int SDLCALL
-SDL_SetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode scaleMode)
+SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect, const Uint8 *Yplane, int Ypitch, const Uint8 *UVplane, int UVpitch)
 {
-    SDL_PropertiesID props = SDL3_GetTextureProperties(texture);
-    if (props) {
-        SDL3_SetNumberProperty(props, PROP_TEXTURE_SCALE_MODE, scaleMode);
-    }
-    if (scaleMode > SDL_SCALEMODE_LINEAR) {
-        scaleMode = SDL_SCALEMODE_LINEAR;
+    SubmitTextureSprites(texture);
+    if (!SDL3_UpdateNVTexture(texture, rect, Yplane, Ypitch, UVplane, UVpitch)) {
+        return -1;
     }
-    return SDL3_SetTextureScaleMode(texture, scaleMode) ? 0 : -1;
+    NoteTextureUpdate(texture, rect);
+    return 0;
 }
 
 SDL_DECLSPEC int SDLCALL
-SDL_GetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode *scaleMode)
+SDL_SetTextureColorMod(SDL_Texture *texture, Uint8 r, Uint8 g, Uint8 b)
 {
-    SDL_PropertiesID props = SDL3_GetTextureProperties(texture);
-    if (props) {
-        Sint64 cached_scale_mode = SDL3_GetNumberProperty(props, PROP_TEXTURE_SCALE_MODE, PROP_TEXTURE_SCALE_MODE_UNAVAILABLE);
-        if (cached_scale_mode != PROP_TEXTURE_SCALE_MODE_UNAVAILABLE) {
-            if (scaleMode) {
-                *scaleMode = (SDL_ScaleMode) cached_scale_mode;
-            }
-            return 0;
+    SubmitTextureSprites(texture);
+    return SDL3_SetTextureColorMod(texture, r, g, b) ? 0 : -1;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_SetTextureAlphaMod(SDL_Texture *texture, Uint8 alpha)
+{
+    SubmitTextureSprites(texture);
+    return SDL3_SetTextureAlphaMod(texture, alpha) ? 0 : -1;
+}
+
+SDL_DECLSPEC int SDLCALL
+SDL_SetTextureBlendMode(SDL_Texture *texture, SDL_BlendMode blendMode)
+{
+    SubmitTextureSprites(texture);
+    return SDL3_SetTextureBlendMode(texture, blendMode) ? 0 : -1;
+}
+
+SDL_DECLSPEC void SDLCALL
+SDL_DestroyTexture(SDL_Texture *texture)
+{
+    /* SDL3_GetRendererFromTexture will do all the CHECK_TEXTURE_MAGIC stuff. */
+    SDL_Renderer *renderer = SDL3_GetRendererFromTexture(texture);
+    SubmitTextureSprites(texture);
+    if (renderer && texture->refcount == 1) {
+        SDL2_TexturePool *pool = GetTexturePool(renderer);
+        if (pool && ReturnTextureToPool(renderer, pool, texture)) {
+            return;
         }
     }
-    return SDL3_GetTextureScaleMode(texture, scaleMode) ? 0 : -1;
+    SDL3_DestroyTexture(texture);
 }
 
 SDL_DECLSPEC int SDLCALL
@@ -7468,12 +10688,21 @@ SDL_Quit(void)
         priorities[i] = SDL3_GetLogPriority(i);
     }
 
+    ResetPixelFormatDetailsCache();
+    FreePaletteMaps();
+    FreeRWopsBridgeCache();
+    ReportIOStats();
+    ResetControllerMappingHashes();
+
     SDL2Compat_Quit();
 
     old_flags = SDL_WasInit(0);
     SDL3_Quit();
     PostQuitSubsystem(old_flags);
 
+    /* after SDL3_Quit(), since the textures and windows it destroys release their SDL2 surfaces to the pool. */
+    FreeSurfacePool();
+
     for (i = 0; i < SDL_LOG_CATEGORY_CUSTOM; i++) {
         SDL3_SetLogPriority(i, priorities[i]);
     }
@@ -7486,6 +10715,11 @@ SDL_QuitSubSystem(Uint32 flags)
         --timer_init;
     }
 
+    /* SDL3 may drop its mappings with the subsystem, so the next bulk load has to add them all again. */
+    if (flags & (SDL_INIT_GAMEPAD | SDL_INIT_JOYSTICK)) {
+        ResetControllerMappingHashes();
+    }
+
     // !!! FIXME: there's cleanup in SDL_Quit that probably needs to be done here, too.
 
     QuitSubsystemInternal(flags);
@@ -9175,8 +12409,6 @@ SDL_SetWindowData(SDL_Window *window, const char *name, void *userdata)
     return prev;
 }
 
-#define PROP_TEXTURE_USERDATA_POINTER "sdl2-compat.texture.userdata"
-
 SDL_DECLSPEC int SDLCALL
 SDL_SetTextureUserData(SDL_Texture *texture, void *userdata)
 {
@@ -9665,18 +12897,39 @@ SDL_GetPixelFormatName(Uint32 format)
     }
 }
 
+/* Like SDL2, RGB formats are shared by everything that asks for them. Indexed formats each get their own palette. */
+static SDL2_PixelFormat *InternedFormats = NULL;
+static SDL_SpinLock InternedFormatsLock = 0;
+
 SDL_DECLSPEC SDL2_PixelFormat * SDLCALL
 SDL_AllocFormat(Uint32 pixel_format)
 {
     SDL2_PixelFormat *format;
+    const SDL_PixelFormatDetails *details;
+
+    SDL3_LockSpinlock(&InternedFormatsLock);
+
+    /* Look it up in our list of previously allocated formats */
+    for (format = InternedFormats; format; format = format->next) {
+        if (pixel_format == format->format) {
+            ++format->refcount;
+            SDL3_UnlockSpinlock(&InternedFormatsLock);
+            return format;
+        }
+    }
 
-    const SDL_PixelFormatDetails *details = SDL3_GetPixelFormatDetails((SDL_PixelFormat)pixel_format);
+    details = SDL3_GetPixelFormatDetails((SDL_PixelFormat)pixel_format);
     if (!details) {
+        SDL3_UnlockSpinlock(&InternedFormatsLock);
         return NULL;
     }
 
     /* Allocate an empty pixel format structure, and initialize it */
     format = (SDL2_PixelFormat *)SDL3_calloc(1, sizeof(*format));
+    if (!format) {
+        SDL3_UnlockSpinlock(&InternedFormatsLock);
+        return NULL;
+    }
     format->format = details->format;
     format->BitsPerPixel = details->bits_per_pixel;
     format->BytesPerPixel = details->bytes_per_pixel;
@@ -9694,17 +12947,48 @@ SDL_AllocFormat(Uint32 pixel_format)
     format->Ashift = details->Ashift;
     format->refcount = 1;
 
+    if (!SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+        /* Cache the RGB formats */
+        format->next = InternedFormats;
+        InternedFormats = format;
+    }
+
+    SDL3_UnlockSpinlock(&InternedFormatsLock);
+
     return format;
 }
 
 SDL_DECLSPEC void SDLCALL
 SDL_FreeFormat(SDL2_PixelFormat *format)
 {
+    SDL2_PixelFormat *prev;
+
     if (!format) {
         SDL3_InvalidParamError("format");
         return;
     }
 
+    SDL3_LockSpinlock(&InternedFormatsLock);
+
+    if (--format->refcount > 0) {
+        SDL3_UnlockSpinlock(&InternedFormatsLock);
+        return;
+    }
+
+    /* Remove this format from our list */
+    if (format == InternedFormats) {
+        InternedFormats = format->next;
+    } else if (InternedFormats) {
+        for (prev = InternedFormats; prev->next; prev = prev->next) {
+            if (prev->next == format) {
+                prev->next = format->next;
+                break;
+            }
+        }
+    }
+
+    SDL3_UnlockSpinlock(&InternedFormatsLock);
+
     if (format->palette) {
         SDL_FreePalette(format->palette);
     }
@@ -9920,6 +13204,7 @@ SDL_SetWindowMouseGrab(SDL_Window *window, SDL2_bool grabbed)
 SDL_DECLSPEC void SDLCALL
 SDL_GL_DeleteContext(SDL_GLContext context)
 {
+    ForgetGLBindFuncs(context);
     (void) SDL3_GL_DestroyContext(context);
 }
 
@@ -9935,6 +13220,16 @@ SDL_DisableScreenSaver(void)
     SDL3_DisableScreenSaver();
 }
 
+/* sdl2-compat extensions are looked up like GL extensions, so apps can use them without linking to anything new. */
+SDL_DECLSPEC void * SDLCALL
+SDL_GL_GetProcAddress(const char *proc)
+{
+    if (proc && SDL3_strcmp(proc, "SDL2Compat_BlitSurfaces") == 0) {
+        return (void *)SDL2Compat_BlitSurfaces;
+    }
+    return SDL3_GL_GetProcAddress(proc);
+}
+
 /* SDL3 added a return value. We just throw it away for SDL2. */
 SDL_DECLSPEC void SDLCALL
 SDL_GL_SwapWindow(SDL_Window *window)
@@ -9961,110 +13256,223 @@ static void *getglfn(const char *fn, bool *okay)
     return retval;
 }
 
-#define GLFN(fn) openglfn_##fn##_t p##fn = (openglfn_##fn##_t) getglfn(#fn, &okay)
+/* GL entry points for SDL_GL_BindTexture() and SDL_GL_UnbindTexture(), loaded once per GL context.
+   Apps with several contexts switch between them, and entry points aren't guaranteed to match across them,
+   so each context gets its own entry. */
+typedef struct SDL2_GLBindFuncs
+{
+    SDL_GLContext context;  /* NULL if the slot is unused. */
+    bool opengl_loaded;
+    bool opengles2_loaded;
+    openglfn_glEnable_t glEnable;
+    openglfn_glDisable_t glDisable;
+    openglfn_glActiveTextureARB_t glActiveTextureARB;
+    openglfn_glActiveTexture_t glActiveTexture;
+    openglfn_glBindTexture_t glBindTexture;
+} SDL2_GLBindFuncs;
+
+#define SDL2_MAX_GL_BIND_CONTEXTS 4
 
+static SDL2_GLBindFuncs GLBindFuncs[SDL2_MAX_GL_BIND_CONTEXTS];
+static int GLBindFuncsNext = 0;  /* the slot replaced when a new context shows up. */
+static SDL_SpinLock GLBindFuncsLock = 0;
 
-SDL_DECLSPEC int SDLCALL
-SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
+#define GLFN(fn) funcs->fn = (openglfn_##fn##_t) getglfn(#fn, &okay)
+
+/* Fills in funcs with the current context's entry points for gl_api, loading them if this context hasn't yet. */
+static bool LoadGLBindFuncs(int gl_api, SDL2_GLBindFuncs *funcs)
 {
-    SDL_PropertiesID props;
-    SDL_Renderer *renderer;
-    Sint64 tex;
+    const SDL_GLContext context = SDL3_GL_GetCurrentContext();
+    bool okay = true;
+    int i;
 
-    /* SDL3_GetRendererFromTexture will do all the CHECK_TEXTURE_MAGIC stuff. */
-    renderer = SDL3_GetRendererFromTexture(texture);
-    if (!renderer) {
-        return -1;
+    if (!context) {
+        SDL3_SetError("No OpenGL context is current");
+        return false;
     }
 
-    props = SDL3_GetTextureProperties(texture);
-    if (!props) {
-        return -1;
+    SDL3_zerop(funcs);
+    SDL3_LockSpinlock(&GLBindFuncsLock);
+    for (i = 0; i < SDL2_MAX_GL_BIND_CONTEXTS; ++i) {
+        if (GLBindFuncs[i].context == context) {
+            *funcs = GLBindFuncs[i];
+            break;
+        }
     }
+    SDL3_UnlockSpinlock(&GLBindFuncsLock);
 
-    /* always flush the renderer here; good enough. SDL2 only flushed if the texture might have changed, but we'll be conservative. */
-    SDL3_FlushRenderer(renderer);
-
-    if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_NUMBER, -1)) != -1) {  // opengl renderer.
-        const Sint64 target = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_TARGET_NUMBER, 0);
-        const Sint64 uv = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_UV_NUMBER, 0);
-        const Sint64 u = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_U_NUMBER, 0);
-        const Sint64 v = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_V_NUMBER, 0);
-
-        bool okay = true;
+    if (gl_api == SDL2_TEXTURE_GL_API_OPENGL) {
+        if (funcs->opengl_loaded) {
+            return true;
+        }
         GLFN(glEnable);
+        GLFN(glDisable);
         GLFN(glActiveTextureARB);
         GLFN(glBindTexture);
-
-        if (!okay) {
-            return -1;
+        funcs->opengl_loaded = okay;
+    } else if (gl_api == SDL2_TEXTURE_GL_API_OPENGLES2) {
+        if (funcs->opengles2_loaded) {
+            return true;
         }
+        GLFN(glActiveTexture);
+        GLFN(glBindTexture);
+        funcs->opengles2_loaded = okay;
+    } else {
+        return false;
+    }
 
-        pglEnable((GLenum) target);
+    if (!okay) {
+        return false;
+    }
 
-        if (u && v) {
-            pglActiveTextureARB(GL_TEXTURE2_ARB);
-            pglBindTexture((GLenum) target, (GLuint) v);
-            pglActiveTextureARB(GL_TEXTURE1_ARB);
-            pglBindTexture((GLenum) target, (GLuint) u);
-            pglActiveTextureARB(GL_TEXTURE0_ARB);
-        } else if (uv) {
-            pglActiveTextureARB(GL_TEXTURE1_ARB);
-            pglBindTexture((GLenum) target, (GLuint) uv);
-            pglActiveTextureARB(GL_TEXTURE0_ARB);
+    /* loaded outside the lock; store them for next time. */
+    funcs->context = context;
+    SDL3_LockSpinlock(&GLBindFuncsLock);
+    for (i = 0; i < SDL2_MAX_GL_BIND_CONTEXTS; ++i) {
+        if (GLBindFuncs[i].context == context) {
+            break;
         }
-        pglBindTexture((GLenum) target, (GLuint) tex);
+    }
+    if (i == SDL2_MAX_GL_BIND_CONTEXTS) {
+        i = GLBindFuncsNext;
+        GLBindFuncsNext = (GLBindFuncsNext + 1) % SDL2_MAX_GL_BIND_CONTEXTS;
+    }
+    GLBindFuncs[i] = *funcs;
+    SDL3_UnlockSpinlock(&GLBindFuncsLock);
+    return true;
+}
+
+/* A new context could get this one's address, and it must not inherit its entry points. */
+static void ForgetGLBindFuncs(SDL_GLContext context)
+{
+    int i;
 
-        if (texw) {
-            *texw = SDL3_GetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_W_FLOAT, 1.0f);
+    SDL3_LockSpinlock(&GLBindFuncsLock);
+    for (i = 0; i < SDL2_MAX_GL_BIND_CONTEXTS; ++i) {
+        if (GLBindFuncs[i].context == context) {
+            SDL3_zero(GLBindFuncs[i]);
         }
-        if (texh) {
-            *texh = SDL3_GetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_H_FLOAT, 1.0f);
+    }
+    SDL3_UnlockSpinlock(&GLBindFuncsLock);
+}
+
+#undef GLFN
+
+static SDL2_TextureInfo *GetGLTextureInfo(SDL_Texture *texture)
+{
+    SDL2_TextureInfo *info = GetTextureInfo(texture);
+    if (info && info->gl_api == SDL2_TEXTURE_GL_API_UNKNOWN) {
+        const SDL_PropertiesID props = SDL3_GetTextureProperties(texture);
+        Sint64 tex;
+        if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_NUMBER, -1)) != -1) {  // opengl renderer.
+            info->gl_api = SDL2_TEXTURE_GL_API_OPENGL;
+            info->gl_texture = (GLuint) tex;
+            info->gl_target = (GLenum) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_TARGET_NUMBER, 0);
+            info->gl_texture_uv = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_UV_NUMBER, 0);
+            info->gl_texture_u = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_U_NUMBER, 0);
+            info->gl_texture_v = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_V_NUMBER, 0);
+            info->gl_texw = SDL3_GetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_W_FLOAT, 1.0f);
+            info->gl_texh = SDL3_GetFloatProperty(props, SDL_PROP_TEXTURE_OPENGL_TEX_H_FLOAT, 1.0f);
+        } else if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_NUMBER, -1)) != -1) {  // opengles2 renderer.
+            info->gl_api = SDL2_TEXTURE_GL_API_OPENGLES2;
+            info->gl_texture = (GLuint) tex;
+            info->gl_target = (GLenum) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_TARGET_NUMBER, 0);
+            info->gl_texture_uv = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_UV_NUMBER, 0);
+            info->gl_texture_u = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_U_NUMBER, 0);
+            info->gl_texture_v = (GLuint) SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_V_NUMBER, 0);
+            info->gl_texw = 1.0f;
+            info->gl_texh = 1.0f;
+        } else {
+            info->gl_api = SDL2_TEXTURE_GL_API_NONE;
         }
-    } else if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_NUMBER, -1)) != -1) {  // opengles2 renderer.
-        const Sint64 target = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_TARGET_NUMBER, 0);
-        const Sint64 uv = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_UV_NUMBER, 0);
-        const Sint64 u = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_U_NUMBER, 0);
-        const Sint64 v = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_V_NUMBER, 0);
+    }
+    return info;
+}
 
-        bool okay = true;
-        GLFN(glActiveTexture);
-        GLFN(glBindTexture);
+SDL_DECLSPEC int SDLCALL
+SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
+{
+    SDL2_RendererState *state;
+    SDL_Renderer *renderer;
+    const SDL2_TextureInfo *info;
+    SDL2_GLBindFuncs gl;
 
-        if (!okay) {
+    /* SDL3_GetRendererFromTexture will do all the CHECK_TEXTURE_MAGIC stuff. */
+    renderer = SDL3_GetRendererFromTexture(texture);
+    if (!renderer) {
+        return -1;
+    }
+
+    info = GetGLTextureInfo(texture);
+    if (!info) {
+        return -1;
+    }
+
+    /* Like SDL2, only flush if queued draws might use or change this texture. Without batching, everything was already flushed. */
+    state = GetRendererState(renderer);
+    if (state && state->batching && IsTextureQueued(state, texture)) {
+        FlushRenderer(renderer, state);
+    }
+
+    if (info->gl_api == SDL2_TEXTURE_GL_API_OPENGL) {
+        const GLenum target = info->gl_target;
+
+        if (!LoadGLBindFuncs(info->gl_api, &gl)) {
             return -1;
         }
 
-        if (u && v) {
-            pglActiveTexture(GL_TEXTURE2);
-            pglBindTexture((GLenum) target, (GLuint) v);
-            pglActiveTexture(GL_TEXTURE1);
-            pglBindTexture((GLenum) target, (GLuint) u);
-            pglActiveTexture(GL_TEXTURE0);
-        } else if (uv) {
-            pglActiveTexture(GL_TEXTURE1);
-            pglBindTexture((GLenum) target, (GLuint) uv);
-            pglActiveTexture(GL_TEXTURE0);
+        gl.glEnable(target);
+
+        if (info->gl_texture_u && info->gl_texture_v) {
+            gl.glActiveTextureARB(GL_TEXTURE2_ARB);
+            gl.glBindTexture(target, info->gl_texture_v);
+            gl.glActiveTextureARB(GL_TEXTURE1_ARB);
+            gl.glBindTexture(target, info->gl_texture_u);
+            gl.glActiveTextureARB(GL_TEXTURE0_ARB);
+        } else if (info->gl_texture_uv) {
+            gl.glActiveTextureARB(GL_TEXTURE1_ARB);
+            gl.glBindTexture(target, info->gl_texture_uv);
+            gl.glActiveTextureARB(GL_TEXTURE0_ARB);
         }
-        pglBindTexture((GLenum) target, (GLuint) tex);
+        gl.glBindTexture(target, info->gl_texture);
+    } else if (info->gl_api == SDL2_TEXTURE_GL_API_OPENGLES2) {
+        const GLenum target = info->gl_target;
 
-        if (texw) {
-            *texw = 1.0f;
+        if (!LoadGLBindFuncs(info->gl_api, &gl)) {
+            return -1;
         }
-        if (texh) {
-            *texh = 1.0f;
+
+        if (info->gl_texture_u && info->gl_texture_v) {
+            gl.glActiveTexture(GL_TEXTURE2);
+            gl.glBindTexture(target, info->gl_texture_v);
+            gl.glActiveTexture(GL_TEXTURE1);
+            gl.glBindTexture(target, info->gl_texture_u);
+            gl.glActiveTexture(GL_TEXTURE0);
+        } else if (info->gl_texture_uv) {
+            gl.glActiveTexture(GL_TEXTURE1);
+            gl.glBindTexture(target, info->gl_texture_uv);
+            gl.glActiveTexture(GL_TEXTURE0);
         }
+        gl.glBindTexture(target, info->gl_texture);
+    } else {
+        return 0;
     }
 
+    if (texw) {
+        *texw = info->gl_texw;
+    }
+    if (texh) {
+        *texh = info->gl_texh;
+    }
     return 0;
 }
 
 SDL_DECLSPEC int SDLCALL
 SDL_GL_UnbindTexture(SDL_Texture *texture)
 {
-    SDL_PropertiesID props;
     SDL_Renderer *renderer;
-    Sint64 tex;
+    const SDL2_TextureInfo *info;
+    SDL2_GLBindFuncs gl;
 
     /* SDL3_GetRendererFromTexture will do all the CHECK_TEXTURE_MAGIC stuff. */
     renderer = SDL3_GetRendererFromTexture(texture);
@@ -10072,78 +13480,61 @@ SDL_GL_UnbindTexture(SDL_Texture *texture)
         return -1;
     }
 
-    props = SDL3_GetTextureProperties(texture);
-    if (!props) {
+    info = GetGLTextureInfo(texture);
+    if (!info) {
         return -1;
     }
 
-    if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_NUMBER, -1)) != -1) {  // opengl renderer.
-        const Sint64 target = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_TARGET_NUMBER, 0);
-        const Sint64 uv = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_UV_NUMBER, 0);
-        const Sint64 u = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_U_NUMBER, 0);
-        const Sint64 v = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGL_TEXTURE_V_NUMBER, 0);
-
-        bool okay = true;
-        GLFN(glDisable);
-        GLFN(glActiveTextureARB);
-        GLFN(glBindTexture);
+    if (info->gl_api == SDL2_TEXTURE_GL_API_OPENGL) {
+        const GLenum target = info->gl_target;
 
-        if (!okay) {
+        if (!LoadGLBindFuncs(info->gl_api, &gl)) {
             return -1;
         }
 
-        if (u && v) {
-            pglActiveTextureARB(GL_TEXTURE2_ARB);
-            pglBindTexture((GLenum) target, 0);
-            pglDisable((GLenum) target);
-            pglActiveTextureARB(GL_TEXTURE1_ARB);
-            pglBindTexture((GLenum) target, 0);
-            pglDisable((GLenum) target);
-            pglActiveTextureARB(GL_TEXTURE0_ARB);
-        } else if (uv) {
-            pglActiveTextureARB(GL_TEXTURE1_ARB);
-            pglBindTexture((GLenum) target, 0);
-            pglDisable((GLenum) target);
-            pglActiveTextureARB(GL_TEXTURE0_ARB);
-        }
-        pglBindTexture((GLenum) target, 0);
-        pglDisable((GLenum) target);
-    } else if ((tex = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_NUMBER, -1)) != -1) {  // opengles2 renderer.
-        const Sint64 target = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_TARGET_NUMBER, 0);
-        const Sint64 uv = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_UV_NUMBER, 0);
-        const Sint64 u = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_U_NUMBER, 0);
-        const Sint64 v = SDL3_GetNumberProperty(props, SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_V_NUMBER, 0);
-
-        bool okay = true;
-        GLFN(glActiveTexture);
-        GLFN(glBindTexture);
+        if (info->gl_texture_u && info->gl_texture_v) {
+            gl.glActiveTextureARB(GL_TEXTURE2_ARB);
+            gl.glBindTexture(target, 0);
+            gl.glDisable(target);
+            gl.glActiveTextureARB(GL_TEXTURE1_ARB);
+            gl.glBindTexture(target, 0);
+            gl.glDisable(target);
+            gl.glActiveTextureARB(GL_TEXTURE0_ARB);
+        } else if (info->gl_texture_uv) {
+            gl.glActiveTextureARB(GL_TEXTURE1_ARB);
+            gl.glBindTexture(target, 0);
+            gl.glDisable(target);
+            gl.glActiveTextureARB(GL_TEXTURE0_ARB);
+        }
+        gl.glBindTexture(target, 0);
+        gl.glDisable(target);
+    } else if (info->gl_api == SDL2_TEXTURE_GL_API_OPENGLES2) {
+        const GLenum target = info->gl_target;
 
-        if (!okay) {
+        if (!LoadGLBindFuncs(info->gl_api, &gl)) {
             return -1;
         }
 
-        if (u && v) {
-            pglActiveTexture(GL_TEXTURE2);
-            pglBindTexture((GLenum) target, 0);
-            pglActiveTexture(GL_TEXTURE1);
-            pglBindTexture((GLenum) target, 0);
-            pglActiveTexture(GL_TEXTURE0);
-        } else if (uv) {
-            pglActiveTexture(GL_TEXTURE1);
-            pglBindTexture((GLenum) target, 0);
-            pglActiveTexture(GL_TEXTURE0);
+        if (info->gl_texture_u && info->gl_texture_v) {
+            gl.glActiveTexture(GL_TEXTURE2);
+            gl.glBindTexture(target, 0);
+            gl.glActiveTexture(GL_TEXTURE1);
+            gl.glBindTexture(target, 0);
+            gl.glActiveTexture(GL_TEXTURE0);
+        } else if (info->gl_texture_uv) {
+            gl.glActiveTexture(GL_TEXTURE1);
+            gl.glBindTexture(target, 0);
+            gl.glActiveTexture(GL_TEXTURE0);
         }
-        pglBindTexture((GLenum) target, 0);
+        gl.glBindTexture(target, 0);
     }
 
-    /* always flush the renderer here, in case of app shenanigans. */
-    SDL3_FlushRenderer(renderer);
+    /* always flush the renderer here, in case of app shenanigans. This also makes SDL3 forget its cached GL state. */
+    FlushRenderer(renderer, GetRendererState(renderer));
 
     return 0;
 }
 
-#undef GLFN
-
 SDL_DECLSPEC void SDLCALL
 SDL_GetClipRect(SDL2_Surface *surface, SDL_Rect *rect)
 {
@@ -10186,13 +13577,193 @@ SDL_SetPixelFormatPalette(SDL2_PixelFormat *format, SDL_Palette *palette)
     return 0;
 }
 
+/* SDL_GetRGB() and friends are called per pixel, and resolving the details can mean a search by masks and then a
+   lookup in SDL3's format table every time, so remember recent results. SDL2_PixelFormat has no room to store them
+   in, and apps build these by hand and change or reuse them, so entries are matched on the format's contents;
+   the pointer only picks the slot. */
+#define SDL2_FORMAT_DETAILS_CACHE_SIZE 8
+
+typedef struct SDL2_FormatDetailsCacheEntry
+{
+    Uint32 format;
+    Uint32 BitsPerPixel;
+    Uint32 Rmask;
+    Uint32 Gmask;
+    Uint32 Bmask;
+    Uint32 Amask;
+    const SDL_PixelFormatDetails *details;
+} SDL2_FormatDetailsCacheEntry;
+
+static SDL2_FormatDetailsCacheEntry FormatDetailsCache[SDL2_FORMAT_DETAILS_CACHE_SIZE];
+static SDL_SpinLock FormatDetailsCacheLock = 0;
+
 static const SDL_PixelFormatDetails *GetPixelFormatDetails(const SDL2_PixelFormat *format2)
 {
-    SDL_PixelFormat format = (SDL_PixelFormat)format2->format;
+    SDL2_FormatDetailsCacheEntry *entry = &FormatDetailsCache[((uintptr_t)format2 / sizeof(*format2)) % SDL2_FORMAT_DETAILS_CACHE_SIZE];
+    const SDL_PixelFormatDetails *details = NULL;
+    SDL_PixelFormat format;
+
+    SDL3_LockSpinlock(&FormatDetailsCacheLock);
+    if (entry->details && entry->format == format2->format && entry->BitsPerPixel == format2->BitsPerPixel &&
+        entry->Rmask == format2->Rmask && entry->Gmask == format2->Gmask && entry->Bmask == format2->Bmask && entry->Amask == format2->Amask) {
+        details = entry->details;
+    }
+    SDL3_UnlockSpinlock(&FormatDetailsCacheLock);
+    if (details) {
+        return details;
+    }
+
+    format = (SDL_PixelFormat)format2->format;
     if (format == SDL_PIXELFORMAT_UNKNOWN) {
         format = SDL3_GetPixelFormatForMasks(format2->BitsPerPixel, format2->Rmask, format2->Gmask, format2->Bmask, format2->Amask);
     }
-    return SDL3_GetPixelFormatDetails(format);
+    details = SDL3_GetPixelFormatDetails(format);
+    if (details) {
+        SDL3_LockSpinlock(&FormatDetailsCacheLock);
+        entry->format = format2->format;
+        entry->BitsPerPixel = format2->BitsPerPixel;
+        entry->Rmask = format2->Rmask;
+        entry->Gmask = format2->Gmask;
+        entry->Bmask = format2->Bmask;
+        entry->Amask = format2->Amask;
+        entry->details = details;
+        SDL3_UnlockSpinlock(&FormatDetailsCacheLock);
+    }
+    return details;
+}
+
+/* SDL3 frees the details when it quits. */
+static void ResetPixelFormatDetailsCache(void)
+{
+    SDL3_LockSpinlock(&FormatDetailsCacheLock);
+    SDL3_zeroa(FormatDetailsCache);
+    SDL3_UnlockSpinlock(&FormatDetailsCacheLock);
+}
+
+/* Inverse color maps for SDL_MapRGB() on indexed formats, which otherwise searches the whole palette every call.
+   Colors are grouped into cells of 8x8x8; a cell is filled in the first time it's used, by mapping its 8 corners.
+   The nearest-color regions are convex, so if all the corners map to the same entry, every color in the cell does.
+   Cells where they don't are marked mixed and keep using the exact search. */
+#define SDL2_PALETTE_MAP_CELLS (32 * 32 * 32)
+#define SDL2_PALETTE_MAP_MIXED 0xFFFF
+#define SDL2_MAX_PALETTE_MAPS  4
+
+typedef struct SDL2_PaletteMap
+{
+    SDL_Palette *palette;  /* we hold a reference, so the address can't be reused for another palette. */
+    Uint32 version;        /* the cells are dropped if the palette's version or size doesn't match these. */
+    int ncolors;
+    Uint16 cells[SDL2_PALETTE_MAP_CELLS];  /* 0 if not filled in yet, entry + 1, or SDL2_PALETTE_MAP_MIXED. */
+} SDL2_PaletteMap;
+
+static SDL2_PaletteMap *PaletteMaps[SDL2_MAX_PALETTE_MAPS];  /* most recently used first. */
+static SDL_SpinLock PaletteMapsLock = 0;
+
+static void FreePaletteMap(SDL2_PaletteMap *map)
+{
+    SDL3_DestroyPalette(map->palette);  /* drops our reference. */
+    SDL3_free(map);
+}
+
+/* Call with PaletteMapsLock held. */
+static SDL2_PaletteMap *GetPaletteMap(SDL_Palette *palette)
+{
+    SDL2_PaletteMap *map = NULL;
+    int i;
+
+    /* drop maps for palettes nobody else is using anymore, including the one used last. */
+    for (i = SDL2_MAX_PALETTE_MAPS - 1; i >= 0; --i) {
+        if (PaletteMaps[i] && PaletteMaps[i]->palette->refcount == 1) {
+            FreePaletteMap(PaletteMaps[i]);
+            SDL3_memmove(&PaletteMaps[i], &PaletteMaps[i + 1], (SDL2_MAX_PALETTE_MAPS - 1 - i) * sizeof(*PaletteMaps));
+            PaletteMaps[SDL2_MAX_PALETTE_MAPS - 1] = NULL;
+        }
+    }
+
+    for (i = 0; i < SDL2_MAX_PALETTE_MAPS && PaletteMaps[i]; ++i) {
+        if (PaletteMaps[i]->palette == palette) {
+            map = PaletteMaps[i];
+            break;
+        }
+    }
+
+    if (!map) {
+        map = (SDL2_PaletteMap *)SDL3_calloc(1, sizeof(*map));
+        if (!map) {
+            return NULL;
+        }
+        map->palette = palette;
+        map->version = palette->version;
+        map->ncolors = palette->ncolors;
+        ++palette->refcount;
+
+        i = SDL2_MAX_PALETTE_MAPS - 1;
+        if (PaletteMaps[i]) {
+            FreePaletteMap(PaletteMaps[i]);
+        }
+    }
+
+    /* move it to the front. */
+    SDL3_memmove(&PaletteMaps[1], &PaletteMaps[0], i * sizeof(*PaletteMaps));
+    PaletteMaps[0] = map;
+
+    /* apps can change the colors without going through us, as long as they bump the version like SDL2 expects. */
+    if (map->version != palette->version || map->ncolors != palette->ncolors) {
+        SDL3_zeroa(map->cells);
+        map->version = palette->version;
+        map->ncolors = palette->ncolors;
+    }
+    return map;
+}
+
+static void FreePaletteMaps(void)
+{
+    int i;
+
+    SDL3_LockSpinlock(&PaletteMapsLock);
+    for (i = 0; i < SDL2_MAX_PALETTE_MAPS; ++i) {
+        if (PaletteMaps[i]) {
+            FreePaletteMap(PaletteMaps[i]);
+            PaletteMaps[i] = NULL;
+        }
+    }
+    SDL3_UnlockSpinlock(&PaletteMapsLock);
+}
+
+static Uint32 MapOpaqueRGBToPalette(const SDL_PixelFormatDetails *format, SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b)
+{
+    const int cell = ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+    SDL2_PaletteMap *map;
+    Uint16 entry = SDL2_PALETTE_MAP_MIXED;
+
+    SDL3_LockSpinlock(&PaletteMapsLock);
+    map = GetPaletteMap(palette);
+    if (map) {
+        entry = map->cells[cell];
+        if (entry == 0) {
+            const Uint8 r0 = (Uint8)(r & ~7), g0 = (Uint8)(g & ~7), b0 = (Uint8)(b & ~7);
+            const Uint32 first = SDL3_MapRGB(format, palette, r0, g0, b0);
+            int corner;
+
+            entry = (Uint16)(first + 1);
+            for (corner = 1; corner < 8; ++corner) {
+                const Uint8 cr = (Uint8)(r0 + ((corner & 1) ? 7 : 0));
+                const Uint8 cg = (Uint8)(g0 + ((corner & 2) ? 7 : 0));
+                const Uint8 cb = (Uint8)(b0 + ((corner & 4) ? 7 : 0));
+                if (SDL3_MapRGB(format, palette, cr, cg, cb) != first) {
+                    entry = SDL2_PALETTE_MAP_MIXED;
+                    break;
+                }
+            }
+            map->cells[cell] = entry;
+        }
+    }
+    SDL3_UnlockSpinlock(&PaletteMapsLock);
+
+    if (entry == SDL2_PALETTE_MAP_MIXED) {
+        return SDL3_MapRGB(format, palette, r, g, b);
+    }
+    return entry - 1;
 }
 
 SDL_DECLSPEC Uint32 SDLCALL
@@ -10208,6 +13779,9 @@ SDL_MapRGB(const SDL2_PixelFormat *format2, Uint8 r, Uint8 g, Uint8 b)
         if (!format) {
             return 0;
         }
+        if (SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+            return MapOpaqueRGBToPalette(format, format2->palette, r, g, b);
+        }
         return SDL3_MapRGB(format, format2->palette, r, g, b);
     }
 
@@ -10232,6 +13806,9 @@ SDL_MapRGBA(const SDL2_PixelFormat *format2, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
         if (!format) {
             return 0;
         }
+        if (a == SDL_ALPHA_OPAQUE && SDL_ISPIXELFORMAT_INDEXED(format->format)) {
+            return MapOpaqueRGBToPalette(format, format2->palette, r, g, b);  /* SDL_MapRGB() maps as opaque, too. */
+        }
         return SDL3_MapRGBA(format, format2->palette, r, g, b, a);
     }
 
@@ -10243,10 +13820,49 @@ SDL_MapRGBA(const SDL2_PixelFormat *format2, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     }
 }
 
+/* The common 32-bit formats are unpacked inline, like SDL_MapRGB() does for XRGB8888. */
+static bool GetRGB8888(Uint32 format, Uint32 pixelvalue, Uint8 *r, Uint8 *g, Uint8 *b)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_XRGB8888:
+    case SDL_PIXELFORMAT_ARGB8888:
+        *r = (Uint8)(pixelvalue >> 16);
+        *g = (Uint8)(pixelvalue >> 8);
+        *b = (Uint8)pixelvalue;
+        return true;
+    case SDL_PIXELFORMAT_XBGR8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        *r = (Uint8)pixelvalue;
+        *g = (Uint8)(pixelvalue >> 8);
+        *b = (Uint8)(pixelvalue >> 16);
+        return true;
+    case SDL_PIXELFORMAT_RGBX8888:
+    case SDL_PIXELFORMAT_RGBA8888:
+        *r = (Uint8)(pixelvalue >> 24);
+        *g = (Uint8)(pixelvalue >> 16);
+        *b = (Uint8)(pixelvalue >> 8);
+        return true;
+    case SDL_PIXELFORMAT_BGRX8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        *r = (Uint8)(pixelvalue >> 8);
+        *g = (Uint8)(pixelvalue >> 16);
+        *b = (Uint8)(pixelvalue >> 24);
+        return true;
+    default:
+        return false;
+    }
+}
+
 SDL_DECLSPEC void SDLCALL
 SDL_GetRGB(Uint32 pixelvalue, const SDL2_PixelFormat *format2, Uint8 *r, Uint8 *g, Uint8 *b)
 {
-    const SDL_PixelFormatDetails *format = GetPixelFormatDetails(format2);
+    const SDL_PixelFormatDetails *format;
+
+    if (GetRGB8888(format2->format, pixelvalue, r, g, b)) {
+        return;
+    }
+
+    format = GetPixelFormatDetails(format2);
     if (!format) {
         *r = *g = *b = 0;
         return;
@@ -10257,7 +13873,26 @@ SDL_GetRGB(Uint32 pixelvalue, const SDL2_PixelFormat *format2, Uint8 *r, Uint8 *
 SDL_DECLSPEC void SDLCALL
 SDL_GetRGBA(Uint32 pixelvalue, const SDL2_PixelFormat *format2, Uint8 *r, Uint8 *g, Uint8 *b, Uint8 *a)
 {
-    const SDL_PixelFormatDetails *format = GetPixelFormatDetails(format2);
+    const SDL_PixelFormatDetails *format;
+
+    if (GetRGB8888(format2->format, pixelvalue, r, g, b)) {
+        switch (format2->format) {
+        case SDL_PIXELFORMAT_ARGB8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            *a = (Uint8)(pixelvalue >> 24);
+            break;
+        case SDL_PIXELFORMAT_RGBA8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            *a = (Uint8)pixelvalue;
+            break;
+        default:
+            *a = SDL_ALPHA_OPAQUE;
+            break;
+        }
+        return;
+    }
+
+    format = GetPixelFormatDetails(format2);
     if (!format) {
         *r = *g = *b = *a = 0;
         return;
@@ -10447,18 +14082,60 @@ SDL_DECLSPEC int SDLCALL
 SDL_LockTextureToSurface(SDL_Texture *texture, const SDL_Rect *rect, SDL2_Surface **surface)
 {
     SDL_Surface *surface3 = NULL;
+    SDL2_TextureInfo *info;
+    SubmitTextureSprites(texture);
     if (!SDL3_LockTextureToSurface(texture, rect, &surface3)) {
         return -1;
     }
+    info = GetTextureInfo(texture);
+    if (!info) {
+        *surface = CreateSurface2from3(surface3);
+        if (!*surface) {
+            SDL_UnlockTexture(texture);
+            return -1;
+        }
+
+        /* This surface is freed by SDL_UnlockTexture() or SDL_DestroyTexture(), not by SDL_FreeSurface() */
+        (*surface)->flags |= SDL_DONTFREE;
+        SDL3_SetPointerPropertyWithCleanup(SDL3_GetSurfaceProperties(surface3), PROP_SURFACE2, *surface, CleanupRetainedSurface2, NULL);
+        return 0;
+    }
+
+    info->locked = true;
+
+    /* Streaming apps lock every frame, so point the SDL2 surface from the last lock at the new SDL3 surface.
+       Indexed surfaces get a new one, since their palette belongs to the SDL3 surface. */
+    if (info->lock_surface && !SDL_ISPIXELFORMAT_INDEXED(surface3->format) && info->lock_surface->format->format == (Uint32)surface3->format) {
+        SDL2_Surface *surface2 = info->lock_surface;
+        surface2->flags = (surface3->flags & SHARED_SURFACE_FLAGS) | SDL_DONTFREE;
+        surface2->w = surface3->w;
+        surface2->h = surface3->h;
+        surface2->pitch = surface3->pitch;
+        surface2->pixels = surface3->pixels;
+        surface2->userdata = NULL;
+        surface2->locked = 0;
+        SDL3_GetSurfaceClipRect(surface3, &surface2->clip_rect);
+        surface2->map = (SDL_BlitMap *)surface3;
+        SDL3_SetPointerProperty(SDL3_GetSurfaceProperties(surface3), PROP_SURFACE2, surface2);
+        surface2->refcount = 1;
+        *surface = surface2;
+        return 0;
+    }
+
     *surface = CreateSurface2from3(surface3);
     if (!*surface) {
         SDL_UnlockTexture(texture);
         return -1;
     }
 
-    /* This surface is freed by SDL_UnlockTexture() or SDL_DestroyTexture(), not by SDL_FreeSurface() */
+    /* This surface is freed with the texture, not by SDL_FreeSurface() */
     (*surface)->flags |= SDL_DONTFREE;
-    SDL3_SetPointerPropertyWithCleanup(SDL3_GetSurfaceProperties(surface3), PROP_SURFACE2, *surface, CleanupRetainedSurface2, NULL);
+    if (info->lock_surface) {
+        info->lock_surface->flags &= ~SDL_DONTFREE;
+        info->lock_surface->map = NULL;
+        SDL_FreeSurface(info->lock_surface);
+    }
+    info->lock_surface = *surface;
     return 0;
 }
 
@@ -97,10 +97,12 @@ SDL3_SYM_RENAMED_RETCODE(bool,AndroidShowToast,ShowAndroidToast,(const char *a,
 SDL3_SYM_PASSTHROUGH(int,GetAndroidSDKVersion,(void),(),return)
 #endif
 
+SDL3_SYM(int,AddGamepadMapping,(const char *a),(a),return)
 SDL3_SYM(int,AddGamepadMappingsFromIO,(SDL_IOStream *a, bool b),(a,b),return)
 SDL3_SYM(bool,AddHintCallback,(const char *a, SDL_HintCallback b, void *c),(a,b,c),)
 SDL3_SYM(SDL_TimerID,AddTimer,(Uint32 a, SDL_TimerCallback b, void *c),(a,b,c),return)
 SDL3_SYM_RENAMED(SDL_Palette*,AllocPalette,CreatePalette,(int a),(a),return)
+SDL3_SYM(SDL_AsyncIO*,AsyncIOFromFile,(const char *a, const char *b),(a,b),return)
 SDL3_SYM_RENAMED(int,AtomicAdd,AddAtomicInt,(SDL_atomic_t *a, int b),(a,b),return)
 SDL3_SYM_RENAMED_BOOL(bool,AtomicCAS,CompareAndSwapAtomicInt,(SDL_atomic_t *a, int b, int c),(a,b,c),return)
 SDL3_SYM_RENAMED_BOOL(bool,AtomicCASPtr,CompareAndSwapAtomicPointer,(void **a, void *b, void *c),(a,b,c),return)
@@ -124,6 +126,7 @@ SDL3_SYM(bool,ClearAudioStream,(SDL_AudioStream *a),(a),return)
 SDL3_SYM(bool,ClearComposition,(SDL_Window *a),(a),return)
 SDL3_SYM(bool,ClearError,(void),(),return)
 SDL3_SYM(bool,ClearProperty,(SDL_PropertiesID a, const char *b),(a,b),return)
+SDL3_SYM(bool,CloseAsyncIO,(SDL_AsyncIO *a, bool b, SDL_AsyncIOQueue *c, void *d),(a,b,c,d),return)
 SDL3_SYM(void,CloseAudioDevice,(SDL_AudioDeviceID a),(a),)
 SDL3_SYM(bool,CloseIO,(SDL_IOStream *a),(a),return)
 SDL3_SYM_PASSTHROUGH(SDL_BlendMode,ComposeCustomBlendMode,(SDL_BlendFactor a, SDL_BlendFactor b, SDL_BlendOperation c, SDL_BlendFactor d, SDL_BlendFactor e, SDL_BlendOperation f),(a,b,c,d,e,f),return)
@@ -131,6 +134,8 @@ SDL3_SYM(bool,ConvertEventToRenderCoordinates,(SDL_Renderer *a, SDL_Event *b),(a
 SDL3_SYM(bool,ConvertPixelsAndColorspace,(int a, int b, SDL_PixelFormat c, SDL_Colorspace d, SDL_PropertiesID e, const void *f, int g, SDL_PixelFormat h, SDL_Colorspace i, SDL_PropertiesID j, void *k, int l),(a,b,c,d,e,f,g,h,i,j,k,l),return)
 SDL3_SYM(SDL_Surface*,ConvertSurface,(SDL_Surface *a, SDL_PixelFormat b),(a,b),return)
 SDL3_SYM(SDL_Surface *,ConvertSurfaceAndColorspace,(SDL_Surface *a, SDL_PixelFormat b, SDL_Palette *c, SDL_Colorspace d, SDL_PropertiesID e),(a,b,c,d,e),return)
+SDL3_SYM(bool,CopyProperties,(SDL_PropertiesID a, SDL_PropertiesID b),(a,b),return)
+SDL3_SYM(SDL_AsyncIOQueue*,CreateAsyncIOQueue,(void),(),return)
 SDL3_SYM(SDL_AudioStream*,CreateAudioStream,(const SDL_AudioSpec *a, const SDL_AudioSpec *b),(a,b),return)
 SDL3_SYM(SDL_Cursor*,CreateColorCursor,(SDL_Surface *a, int b, int c),(a,b,c),return)
 SDL3_SYM_RENAMED(SDL_Condition*,CreateCond,CreateCondition,(void),(),return)
@@ -155,6 +160,7 @@ SDL3_SYM(SDL_Window*,CreateWindowWithProperties,(SDL_PropertiesID a),(a),return)
 SDL3_SYM(bool,CursorVisible,(void),(),return)
 SDL3_SYM(void,RemoveHintCallback,(const char *a, SDL_HintCallback b, void *c),(a,b,c),)
 SDL3_SYM_PASSTHROUGH(void,Delay,(Uint32 a),(a),)
+SDL3_SYM(void,DestroyAsyncIOQueue,(SDL_AsyncIOQueue *a),(a),)
 SDL3_SYM(void,DestroyAudioStream,(SDL_AudioStream *a),(a),)
 SDL3_SYM_RENAMED(void,DestroyCond,DestroyCondition,(SDL_Condition *a),(a),)
 SDL3_SYM(void,DestroyEnvironment,(SDL_Environment *a),(a),)
@@ -164,7 +170,7 @@ SDL3_SYM(void,DestroyProperties,(SDL_PropertiesID a),(a),)
 SDL3_SYM_PASSTHROUGH(void,DestroyRenderer,(SDL_Renderer *a),(a),)
 SDL3_SYM_PASSTHROUGH(void,DestroySemaphore,(SDL_Semaphore *a),(a),)
 SDL3_SYM(void,DestroySurface,(SDL_Surface *a),(a),)
-SDL3_SYM_PASSTHROUGH(void,DestroyTexture,(SDL_Texture *a),(a),)
+SDL3_SYM(void,DestroyTexture,(SDL_Texture *a),(a),)
 SDL3_SYM_PASSTHROUGH(void,DestroyWindow,(SDL_Window *a),(a),)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,DestroyWindowSurface,(SDL_Window *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void,DetachThread,(SDL_Thread *a),(a),)
@@ -180,8 +186,10 @@ SDL3_SYM(bool,FillSurfaceRects,(SDL_Surface *a, const SDL_Rect *b, int c, Uint32
 SDL3_SYM(void,FilterEvents,(SDL_EventFilter a, void *b),(a,b),)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,FlashWindow,(SDL_Window *a, SDL_FlashOperation b),(a,b),return)
 SDL3_SYM(bool,FlushAudioStream,(SDL_AudioStream *a),(a),return)
+SDL3_SYM(bool,FlushRenderer,(SDL_Renderer *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void,FlushEvent,(Uint32 a),(a),)
 SDL3_SYM_PASSTHROUGH(void,FlushEvents,(Uint32 a, Uint32 b),(a,b),)
+SDL3_SYM(bool,FlushIO,(SDL_IOStream *a),(a),return)
 SDL3_SYM_RENAMED(void,FreeCursor,DestroyCursor,(SDL_Cursor *a),(a),)
 SDL3_SYM_PASSTHROUGH(SDL_GLContext,GL_CreateContext,(SDL_Window *a),(a),return)
 SDL3_SYM(bool,GL_DestroyContext,(SDL_GLContext a),(a),return)
@@ -189,7 +197,7 @@ SDL3_SYM_PASSTHROUGH_BOOL(bool,GL_ExtensionSupported,(const char *a),(a),return)
 SDL3_SYM(bool,GL_GetAttribute,(SDL_GLAttr a, int *b),(a,b),return)
 SDL3_SYM_PASSTHROUGH(SDL_GLContext,GL_GetCurrentContext,(void),(),return)
 SDL3_SYM_PASSTHROUGH(SDL_Window*,GL_GetCurrentWindow,(void),(),return)
-SDL3_SYM_PASSTHROUGH(void*,GL_GetProcAddress,(const char *a),(a),return)
+SDL3_SYM(void*,GL_GetProcAddress,(const char *a),(a),return)
 SDL3_SYM(bool,GL_GetSwapInterval,(int *a),(a),return)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,GL_LoadLibrary,(const char *a),(a),return)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,GL_MakeCurrent,(SDL_Window *a, SDL_GLContext b),(a,b),return)
@@ -200,7 +208,6 @@ SDL3_SYM(bool,GL_SwapWindow,(SDL_Window *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void,GL_UnloadLibrary,(void),(),)
 SDL3_SYM_RENAMED(SDL_GUID,GUIDFromString,StringToGUID,(const char *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void,GUIDToString,(SDL_GUID a, char *b, int c),(a,b,c),)
-SDL3_SYM_RENAMED(int,GameControllerAddMapping,AddGamepadMapping,(const char *a),(a),return)
 SDL3_SYM_RENAMED(void,GameControllerClose,CloseGamepad,(SDL_GameController *a),(a),)
 SDL3_SYM_RENAMED(SDL_GameController*,GameControllerFromPlayerIndex,GetGamepadFromPlayerIndex,(int a),(a),return)
 SDL3_SYM_RENAMED(const char*,GameControllerGetAppleSFSymbolsNameForAxis,GetGamepadAppleSFSymbolsNameForAxis,(SDL_GameController *a, SDL_GameControllerAxis b),(a,b),return)
@@ -241,6 +248,8 @@ SDL3_SYM_RENAMED(void,GameControllerUpdate,UpdateGamepads,(void),(),)
 SDL3_SYM(bool,GamepadEventsEnabled,(void),(),return)
 SDL3_SYM_PASSTHROUGH(SDL_AssertionHandler,GetAssertionHandler,(void **a),(a),return)
 SDL3_SYM_PASSTHROUGH(const SDL_AssertData*,GetAssertionReport,(void),(),return)
+SDL3_SYM(bool,GetAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b),(a,b),return)
+SDL3_SYM(Sint64,GetAsyncIOSize,(SDL_AsyncIO *a),(a),return)
 SDL3_SYM(bool,GetAudioDeviceFormat,(SDL_AudioDeviceID a, SDL_AudioSpec *b, int *c),(a,b,c),return)
 SDL3_SYM(const char*,GetAudioDeviceName,(SDL_AudioDeviceID a),(a),return)
 SDL3_SYM_PASSTHROUGH(const char*,GetAudioDriver,(int a),(a),return)
@@ -304,6 +313,7 @@ SDL3_SYM(const char*,GetHint,(const char *a),(a),return)
 SDL3_SYM(bool,GetHintBoolean,(const char *a, bool b),(a,b),return)
 SDL3_SYM(SDL_PropertiesID,GetIOProperties,(SDL_IOStream *a),(a),return)
 SDL3_SYM(Sint64,GetIOSize,(SDL_IOStream *a),(a),return)
+SDL3_SYM(SDL_IOStatus,GetIOStatus,(SDL_IOStream *a),(a),return)
 SDL3_SYM(SDL_JoystickConnectionState,GetJoystickConnectionState,(SDL_Joystick *a),(a),return)
 SDL3_SYM(SDL_Joystick*,GetJoystickFromID,(SDL_JoystickID a),(a),return)
 SDL3_SYM(SDL_GUID,GetJoystickGUIDForID,(SDL_JoystickID a),(a),return)
@@ -358,6 +368,7 @@ SDL3_SYM_PASSTHROUGH_RETCODE(bool,GetRenderDrawColor,(SDL_Renderer *a, Uint8 *b,
 SDL3_SYM(const char *,GetRenderDriver,(int a),(a),return);
 SDL3_SYM(bool,GetRenderLogicalPresentation,(SDL_Renderer *a, int *b, int *c, SDL_RendererLogicalPresentation *d),(a,b,c,d),return)
 SDL3_SYM(bool,GetRenderLogicalPresentationRect,(SDL_Renderer *a, SDL_FRect *b),(a,b),return)
+SDL3_SYM(void*,GetRenderMetalCommandEncoder,(SDL_Renderer *a),(a),return)
 SDL3_SYM(bool,GetRenderScale,(SDL_Renderer *a, float *b, float *c),(a,b,c),return)
 SDL3_SYM_PASSTHROUGH(SDL_Texture*,GetRenderTarget,(SDL_Renderer *a),(a),return)
 SDL3_SYM(bool,GetRenderViewport,(SDL_Renderer *a, SDL_Rect *b),(a,b),return)
@@ -396,6 +407,7 @@ SDL3_SYM(bool,GetTextureSize,(SDL_Texture *a, float *b, float *c),(a,b),return)
 SDL3_SYM(Uint64,GetThreadID,(SDL_Thread *a),(a),return)
 SDL3_SYM_PASSTHROUGH(const char*,GetThreadName,(SDL_Thread *a),(a),return)
 SDL3_SYM(Uint64,GetTicks,(void),(),return)
+SDL3_SYM(Uint64,GetTicksNS,(void),(),return)
 SDL3_SYM(const char*,GetTouchDeviceName,(SDL_TouchID a),(a),return)
 SDL3_SYM_PASSTHROUGH(SDL_TouchDeviceType,GetTouchDeviceType,(SDL_TouchID a),(a),return)
 SDL3_SYM(SDL_TouchID*,GetTouchDevices,(int *a),(a),return)
@@ -522,7 +534,7 @@ SDL3_SYM(bool,LoadWAV_IO,(SDL_IOStream *a, bool b, SDL_AudioSpec *c, Uint8 **d,
 SDL3_SYM(bool,LockAudioStream,(SDL_AudioStream *a),(a),return)
 SDL3_SYM(void,LockMutex,(SDL_Mutex *a),(a),)
 SDL3_SYM(bool,LockSurface,(SDL_Surface *a),(a),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,LockTexture,(SDL_Texture *a, const SDL_Rect *b, void **c, int *d),(a,b,c,d),return)
+SDL3_SYM(bool,LockTexture,(SDL_Texture *a, const SDL_Rect *b, void **c, int *d),(a,b,c,d),return)
 SDL3_SYM(bool,LockTextureToSurface,(SDL_Texture *a, const SDL_Rect *b, SDL_Surface **c),(a,b,c),return)
 SDL3_SYM(void,GetLogOutputFunction,(SDL_LogOutputFunction *a, void **b),(a,b),)
 SDL3_SYM(SDL_LogPriority,GetLogPriority,(int a),(a),return)
@@ -567,6 +579,7 @@ SDL3_SYM(bool,PutAudioStreamData,(SDL_AudioStream *a, const void *b, int c),(a,b
 SDL3_SYM(void,Quit,(void),(),)
 SDL3_SYM(void,QuitSubSystem,(Uint32 a),(a),)
 SDL3_SYM(bool,RaiseWindow,(SDL_Window *a),(a),return)
+SDL3_SYM(bool,ReadAsyncIO,(SDL_AsyncIO *a, void *b, Uint64 c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
 SDL3_SYM(size_t,ReadIO,(SDL_IOStream *a, void *b, size_t c),(a,b,c),return)
 SDL3_SYM(Uint32,RegisterEvents,(int a),(a),return)
 SDL3_SYM(bool,RemoveTimer,(SDL_TimerID a),(a),return)
@@ -575,9 +588,7 @@ SDL3_SYM(bool,RenderCoordinatesFromWindow,(SDL_Renderer *a, float b, float c, fl
 SDL3_SYM(bool,RenderCoordinatesToWindow,(SDL_Renderer *a, float b, float c, float *d, float *e),(a,b,c,d,e),return)
 SDL3_SYM(bool,RenderFillRect,(SDL_Renderer *a, const SDL_FRect *b),(a,b),return)
 SDL3_SYM(bool,RenderFillRects,(SDL_Renderer *a, const SDL_FRect *b, int c),(a,b,c),return)
-SDL3_SYM_RENAMED_RETCODE(bool,RenderFlush,FlushRenderer,(SDL_Renderer *a),(a),return)
 SDL3_SYM(bool,RenderGeometryRaw,(SDL_Renderer *a, SDL_Texture *b, const float *c, int d, const SDL_FColor *e, int f, const float *g, int h, int i, const void *j, int k, int l),(a,b,c,d,e,f,g,h,i,j,k,l),return)
-SDL3_SYM_RENAMED(void*,RenderGetMetalCommandEncoder,GetRenderMetalCommandEncoder,(SDL_Renderer *a),(a),return)
 SDL3_SYM_RENAMED(void*,RenderGetMetalLayer,GetRenderMetalLayer,(SDL_Renderer *a),(a),return)
 SDL3_SYM_RENAMED(SDL_Window*,RenderGetWindow,GetRenderWindow,(SDL_Renderer *a),(a),return)
 SDL3_SYM_RENAMED_BOOL(bool,RenderIsClipEnabled,RenderClipEnabled,(SDL_Renderer *a),(a),return)
@@ -587,7 +598,6 @@ SDL3_SYM(bool,RenderPresent,(SDL_Renderer *a),(a),return)
 SDL3_SYM(SDL_Surface *,RenderReadPixels,(SDL_Renderer *a, const SDL_Rect *b),(a,b),return)
 SDL3_SYM(bool,RenderRect,(SDL_Renderer *a, const SDL_FRect *b),(a,b),return)
 SDL3_SYM(bool,RenderRects,(SDL_Renderer *a, const SDL_FRect *b, int c),(a,b,c),return)
-SDL3_SYM_RENAMED_RETCODE(bool,RenderSetScale,SetRenderScale,(SDL_Renderer *a, float b, float c),(a,b,c),return)
 SDL3_SYM_RENAMED_RETCODE(bool,RenderSetVSync,SetRenderVSync,(SDL_Renderer *a, int b),(a,b),return)
 SDL3_SYM(bool,RenderTexture,(SDL_Renderer *a, SDL_Texture *b, const SDL_FRect *c, const SDL_FRect *d),(a,b,c,d),return)
 SDL3_SYM(bool,RenderTextureRotated,(SDL_Renderer *a, SDL_Texture *b, const SDL_FRect *c, const SDL_FRect *d, double e, const SDL_FPoint *f, SDL_FlipMode g),(a,b,c,d,e,f,g),return)
@@ -639,6 +649,7 @@ SDL3_SYM(bool,SetRenderClipRect,(SDL_Renderer *a, const SDL_Rect *b),(a,b),retur
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,SetRenderDrawBlendMode,(SDL_Renderer *a, SDL_BlendMode b),(a,b),return)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,SetRenderDrawColor,(SDL_Renderer *a, Uint8 b, Uint8 c, Uint8 d, Uint8 e),(a,b,c,d,e),return)
 SDL3_SYM(bool,SetRenderLogicalPresentation,(SDL_Renderer *a, int b, int c, SDL_RendererLogicalPresentation d),(a,b,c,d),return)
+SDL3_SYM(bool,SetRenderScale,(SDL_Renderer *a, float b, float c),(a,b,c),return)
 SDL3_SYM(bool,SetRenderTarget,(SDL_Renderer *a, SDL_Texture *b),(a,b),return)
 SDL3_SYM(bool,SetRenderViewport,(SDL_Renderer *a, const SDL_Rect *b),(a,b),return)
 SDL3_SYM(bool,SetStringProperty,(SDL_PropertiesID a, const char *b, const char *c),(a,b,c),return)
@@ -651,9 +662,9 @@ SDL3_SYM(bool,SetSurfacePalette,(SDL_Surface *a, SDL_Palette *b),(a,b),return)
 SDL3_SYM(bool,SetSurfaceRLE,(SDL_Surface *a, bool b),(a,b),return)
 SDL3_SYM(bool,SetTLS,(SDL_TLSID *a, const void *b, SDL_TLSDestructorCallback c),(a,b,c),return)
 SDL3_SYM(bool,SetTextInputArea,(SDL_Window *a, const SDL_Rect *b, int c),(a,b,c),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,SetTextureAlphaMod,(SDL_Texture *a, Uint8 b),(a,b),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,SetTextureBlendMode,(SDL_Texture *a, SDL_BlendMode b),(a,b),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,SetTextureColorMod,(SDL_Texture *a, Uint8 b, Uint8 c, Uint8 d),(a,b,c,d),return)
+SDL3_SYM(bool,SetTextureAlphaMod,(SDL_Texture *a, Uint8 b),(a,b),return)
+SDL3_SYM(bool,SetTextureBlendMode,(SDL_Texture *a, SDL_BlendMode b),(a,b),return)
+SDL3_SYM(bool,SetTextureColorMod,(SDL_Texture *a, Uint8 b, Uint8 c, Uint8 d),(a,b,c,d),return)
 SDL3_SYM(bool,SetTextureScaleMode,(SDL_Texture *a, SDL_ScaleMode b),(a,b),return)
 SDL3_SYM_RENAMED_RETCODE(bool,SetThreadPriority,SetCurrentThreadPriority,(SDL_ThreadPriority a),(a),return)
 SDL3_SYM(bool,SetWindowAlwaysOnTop,(SDL_Window *a, bool b),(a,b),return)
@@ -700,19 +711,20 @@ SDL3_SYM(void,UnloadObject,(SDL_SharedObject *a),(a),)
 SDL3_SYM(bool,UnlockAudioStream,(SDL_AudioStream *a),(a),return)
 SDL3_SYM(void,UnlockMutex,(SDL_Mutex *a),(a),)
 SDL3_SYM(void,UnlockSurface,(SDL_Surface *a),(a),)
-SDL3_SYM_PASSTHROUGH(void,UnlockTexture,(SDL_Texture *a),(a),)
+SDL3_SYM(void,UnlockTexture,(SDL_Texture *a),(a),)
 SDL3_SYM(bool,UnsetEnvironmentVariable,(SDL_Environment *a, const char *b),(a,b),return)
 SDL3_SYM(bool,UpdateHapticEffect,(SDL_Haptic *a, int b, const SDL_HapticEffect *c),(a,b,c),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,UpdateNVTexture,(SDL_Texture *a, const SDL_Rect *b, const Uint8 *c, int d, const Uint8 *e, int f),(a,b,c,d,e,f),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,UpdateTexture,(SDL_Texture *a, const SDL_Rect *b, const void *c, int d),(a,b,c,d),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,UpdateWindowSurface,(SDL_Window *a),(a),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,UpdateWindowSurfaceRects,(SDL_Window *a, const SDL_Rect *b, int c),(a,b,c),return)
-SDL3_SYM_PASSTHROUGH_RETCODE(bool,UpdateYUVTexture,(SDL_Texture *a, const SDL_Rect *b, const Uint8 *c, int d, const Uint8 *e, int f, const Uint8 *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL3_SYM(bool,UpdateNVTexture,(SDL_Texture *a, const SDL_Rect *b, const Uint8 *c, int d, const Uint8 *e, int f),(a,b,c,d,e,f),return)
+SDL3_SYM(bool,UpdateTexture,(SDL_Texture *a, const SDL_Rect *b, const void *c, int d),(a,b,c,d),return)
+SDL3_SYM(bool,UpdateWindowSurface,(SDL_Window *a),(a),return)
+SDL3_SYM(bool,UpdateWindowSurfaceRects,(SDL_Window *a, const SDL_Rect *b, int c),(a,b,c),return)
+SDL3_SYM(bool,UpdateYUVTexture,(SDL_Texture *a, const SDL_Rect *b, const Uint8 *c, int d, const Uint8 *e, int f, const Uint8 *g, int h),(a,b,c,d,e,f,g,h),return)
 SDL3_SYM(bool,Vulkan_CreateSurface,(SDL_Window *a, VkInstance b, const struct VkAllocationCallbacks *c, VkSurfaceKHR *d),(a,b,c,d),return)
 SDL3_SYM(char const* const* ,Vulkan_GetInstanceExtensions,(Uint32 *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void*,Vulkan_GetVkGetInstanceProcAddr,(void),(),return)
 SDL3_SYM_PASSTHROUGH_RETCODE(bool,Vulkan_LoadLibrary,(const char *a),(a),return)
 SDL3_SYM_PASSTHROUGH(void,Vulkan_UnloadLibrary,(void),(),)
+SDL3_SYM(bool,WaitAsyncIOResult,(SDL_AsyncIOQueue *a, SDL_AsyncIOOutcome *b, Sint32 c),(a,b,c),return)
 SDL3_SYM(void,WaitCondition,(SDL_Condition *a, SDL_Mutex *b),(a,b),return)
 SDL3_SYM(bool,WaitConditionTimeout,(SDL_Condition *a, SDL_Mutex *b, Sint32 c),(a,b,c),return)
 SDL3_SYM(bool,WaitEventTimeout,(SDL_Event *a, Sint32 b),(a,b),return)
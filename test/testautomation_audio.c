@@ -1216,6 +1216,158 @@ int audio_resampleLoss(void)
   return TEST_COMPLETED;
 }
 
+/**
+ * \brief Load a 16-bit stereo WAV from memory, with a chunk to skip and a partial sample frame at the end.
+ *
+ * \sa https://wiki.libsdl.org/SDL_LoadWAV_RW
+ */
+int audio_loadWAV(void)
+{
+    Uint8 wav[12 + 12 + 24 + 8 + 42];
+    Uint8 *p = wav;
+    Uint8 *samples;
+    Uint8 *audio_buf = NULL;
+    Uint32 audio_len = 0;
+    SDL_AudioSpec spec;
+    SDL_AudioSpec *result;
+    SDL_RWops *rw;
+    int i;
+
+#define PUT32(x) do { Uint32 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p[2] = (Uint8)(v_ >> 16); p[3] = (Uint8)(v_ >> 24); p += 4; } while (0)
+#define PUT16(x) do { Uint16 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p += 2; } while (0)
+    SDL_memcpy(p, "RIFF", 4); p += 4;
+    PUT32(sizeof(wav) - 8);
+    SDL_memcpy(p, "WAVE", 4); p += 4;
+    SDL_memcpy(p, "LIST", 4); p += 4;  /* odd length, so it's followed by a pad byte. */
+    PUT32(3);
+    SDL_memcpy(p, "abc", 4); p += 4;
+    SDL_memcpy(p, "fmt ", 4); p += 4;
+    PUT32(16);
+    PUT16(1);          /* PCM */
+    PUT16(2);          /* channels */
+    PUT32(22050);      /* frequency */
+    PUT32(22050 * 4);  /* bytes per second */
+    PUT16(4);          /* block align */
+    PUT16(16);         /* bits per sample */
+    SDL_memcpy(p, "data", 4); p += 4;
+    PUT32(42);  /* ten sample frames and half of another. */
+#undef PUT16
+#undef PUT32
+    samples = p;
+    for (i = 0; i < 42; i++) {
+        samples[i] = (Uint8)(i * 3);
+    }
+
+    rw = SDL_RWFromConstMem(wav, sizeof(wav));
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_RWFromConstMem() result is not NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    result = SDL_LoadWAV_RW(rw, 1, &spec, &audio_buf, &audio_len);
+    SDLTest_AssertPass("Call to SDL_LoadWAV_RW()");
+    SDLTest_AssertCheck(result == &spec, "Verify result is the given spec, got: %p", (void *)result);
+    if (result == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(spec.format == AUDIO_S16LSB, "Verify format; expected: 0x%x, got: 0x%x", AUDIO_S16LSB, spec.format);
+    SDLTest_AssertCheck(spec.channels == 2, "Verify channels; expected: 2, got: %d", spec.channels);
+    SDLTest_AssertCheck(spec.freq == 22050, "Verify frequency; expected: 22050, got: %d", spec.freq);
+    SDLTest_AssertCheck(audio_len == 40, "Verify length is whole sample frames; expected: 40, got: %d", (int)audio_len);
+    SDLTest_AssertCheck(audio_buf && SDL_memcmp(audio_buf, samples, 40) == 0, "Verify samples match");
+    SDL_FreeWAV(audio_buf);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Load 32-bit float stereo WAVs from memory, with fact and LIST chunks between the format and the data.
+ *
+ * \sa https://wiki.libsdl.org/SDL_LoadWAV_RW
+ */
+int audio_loadWAVFloat(void)
+{
+    Uint8 wav[12 + 48 + 12 + 14 + 8 + 64];
+    float samples[16];
+    int variant;
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(samples); i++) {
+        samples[i] = (float)(i - 8) / 8.0f;
+    }
+
+    /* variant 0 has an 18-byte WAVE_FORMAT_IEEE_FLOAT format, variant 1 a WAVE_FORMAT_EXTENSIBLE one. */
+    for (variant = 0; variant < 2; variant++) {
+        const Uint32 fmt_len = variant ? 40 : 18;
+        Uint8 *p = wav;
+        Uint8 *audio_buf = NULL;
+        Uint32 audio_len = 0;
+        SDL_AudioSpec spec;
+        SDL_AudioSpec *result;
+        SDL_RWops *rw;
+        size_t wav_len;
+
+#define PUT32(x) do { Uint32 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p[2] = (Uint8)(v_ >> 16); p[3] = (Uint8)(v_ >> 24); p += 4; } while (0)
+#define PUT16(x) do { Uint16 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p += 2; } while (0)
+        SDL_memcpy(p, "RIFF", 4); p += 4;
+        p += 4;  /* filled in below. */
+        SDL_memcpy(p, "WAVE", 4); p += 4;
+        SDL_memcpy(p, "fmt ", 4); p += 4;
+        PUT32(fmt_len);
+        PUT16(variant ? 0xFFFE : 3);  /* WAVE_FORMAT_EXTENSIBLE or WAVE_FORMAT_IEEE_FLOAT */
+        PUT16(2);          /* channels */
+        PUT32(48000);      /* frequency */
+        PUT32(48000 * 8);  /* bytes per second */
+        PUT16(8);          /* block align */
+        PUT16(32);         /* bits per sample */
+        PUT16((Uint16)(fmt_len - 18));  /* extra format bytes */
+        if (variant) {
+            static const Uint8 float_guid_tail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+            PUT16(32);  /* valid bits per sample */
+            PUT32(3);   /* front left and right */
+            PUT16(3);   /* the subformat GUID starts with the real format tag */
+            SDL_memcpy(p, float_guid_tail, sizeof(float_guid_tail)); p += sizeof(float_guid_tail);
+        }
+        SDL_memcpy(p, "fact", 4); p += 4;
+        PUT32(4);
+        PUT32(8);  /* sample frames */
+        SDL_memcpy(p, "LIST", 4); p += 4;  /* odd length, so it's followed by a pad byte. */
+        PUT32(5);
+        SDL_memcpy(p, "INFOx", 6); p += 6;
+        SDL_memcpy(p, "data", 4); p += 4;
+        PUT32(sizeof(samples));
+        for (i = 0; i < (int)SDL_arraysize(samples); i++) {
+            union { float f; Uint32 u; } sample;
+            sample.f = samples[i];
+            PUT32(sample.u);
+        }
+        wav_len = (size_t)(p - wav);
+        p = wav + 4;
+        PUT32((Uint32)(wav_len - 8));
+#undef PUT16
+#undef PUT32
+
+        rw = SDL_RWFromConstMem(wav, (int)wav_len);
+        SDLTest_AssertCheck(rw != NULL, "Verify SDL_RWFromConstMem() result is not NULL");
+        if (rw == NULL) {
+            return TEST_ABORTED;
+        }
+        result = SDL_LoadWAV_RW(rw, 1, &spec, &audio_buf, &audio_len);
+        SDLTest_AssertPass("Call to SDL_LoadWAV_RW(), %s format", variant ? "extensible" : "float");
+        SDLTest_AssertCheck(result == &spec, "Verify result is the given spec, got: %p", (void *)result);
+        if (result == NULL) {
+            return TEST_ABORTED;
+        }
+        SDLTest_AssertCheck(spec.format == AUDIO_F32LSB, "Verify format; expected: 0x%x, got: 0x%x", AUDIO_F32LSB, spec.format);
+        SDLTest_AssertCheck(spec.channels == 2, "Verify channels; expected: 2, got: %d", spec.channels);
+        SDLTest_AssertCheck(spec.freq == 48000, "Verify frequency; expected: 48000, got: %d", spec.freq);
+        SDLTest_AssertCheck(audio_len == sizeof(samples), "Verify length; expected: %d, got: %d", (int)sizeof(samples), (int)audio_len);
+        SDLTest_AssertCheck(audio_buf && audio_len == sizeof(samples) && SDL_memcmp(audio_buf, wav + wav_len - sizeof(samples), sizeof(samples)) == 0, "Verify samples match");
+        SDL_FreeWAV(audio_buf);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1288,11 +1440,20 @@ static const SDLTest_TestCaseReference audioTest16 = {
     (SDLTest_TestCaseFp)audio_resampleLoss, "audio_resampleLoss", "Check signal-to-noise ratio and maximum error of audio resampling.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest17 = {
+    (SDLTest_TestCaseFp)audio_loadWAV, "audio_loadWAV", "Load a PCM WAV from memory.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest18 = {
+    (SDLTest_TestCaseFp)audio_loadWAVFloat, "audio_loadWAVFloat", "Load float WAVs with fact and LIST chunks from memory.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17,
+    &audioTest18, NULL
 };
 
 /* Audio test suite (global) */
@@ -75,6 +75,68 @@ TestVirtualJoystick(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * @brief Check loading a controller mapping database more than once
+ *
+ * @sa SDL_GameControllerAddMappingsFromRW
+ */
+static int
+TestControllerMappingsFromRW(void *arg)
+{
+    const char *guid = "03000000de2800000112000001000000";
+    char database[512];
+    char override[128];
+    char *mapping;
+    SDL_RWops *rw;
+    int rc;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) == 0, "SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER)");
+
+    SDL_snprintf(database, sizeof(database),
+                 "# Test controller database\r\n"
+                 "\r\n"
+                 "%s,Test Controller,a:b0,b:b1,platform:%s,\r\n"
+                 "%s,Other Platform Controller,a:b0,b:b1,platform:Not A Platform,\n"
+                 "%s,Unterminated Controller,a:b0,platform:%s,",
+                 guid, SDL_GetPlatform(), guid, "03000000de2800000212000001000000", SDL_GetPlatform());
+
+    rw = SDL_RWFromConstMem(database, (int)SDL_strlen(database));
+    rc = SDL_GameControllerAddMappingsFromRW(rw, 1);
+    SDLTest_AssertCheck(rc == 2, "SDL_GameControllerAddMappingsFromRW() added 2 mappings, got %d", rc);
+
+    mapping = SDL_GameControllerMappingForGUID(SDL_JoystickGetGUIDFromString(guid));
+    SDLTest_AssertCheck(mapping && SDL_strstr(mapping, "Test Controller") != NULL, "SDL_GameControllerMappingForGUID() found the mapping for this platform");
+    SDL_free(mapping);
+
+    rw = SDL_RWFromConstMem(database, (int)SDL_strlen(database));
+    rc = SDL_GameControllerAddMappingsFromRW(rw, 1);
+    SDLTest_AssertCheck(rc == 0, "SDL_GameControllerAddMappingsFromRW() added nothing the second time, got %d", rc);
+
+    /* Another database overrides the mapping, then the first one is loaded again: the last load wins, as in SDL2. */
+    SDL_snprintf(override, sizeof(override), "%s,Override Controller,a:b1,b:b0,platform:%s,\n", guid, SDL_GetPlatform());
+    rw = SDL_RWFromConstMem(override, (int)SDL_strlen(override));
+    rc = SDL_GameControllerAddMappingsFromRW(rw, 1);
+    SDLTest_AssertCheck(rc == 0, "SDL_GameControllerAddMappingsFromRW() replaced a mapping, got %d", rc);
+
+    mapping = SDL_GameControllerMappingForGUID(SDL_JoystickGetGUIDFromString(guid));
+    SDLTest_AssertCheck(mapping && SDL_strstr(mapping, "Override Controller") != NULL, "SDL_GameControllerMappingForGUID() found the overriding mapping");
+    SDL_free(mapping);
+
+    rw = SDL_RWFromConstMem(database, (int)SDL_strlen(database));
+    rc = SDL_GameControllerAddMappingsFromRW(rw, 1);
+    SDLTest_AssertCheck(rc == 0, "SDL_GameControllerAddMappingsFromRW() replaced a mapping again, got %d", rc);
+
+    mapping = SDL_GameControllerMappingForGUID(SDL_JoystickGetGUIDFromString(guid));
+    SDLTest_AssertCheck(mapping && SDL_strstr(mapping, "Test Controller") != NULL, "SDL_GameControllerMappingForGUID() found the reloaded mapping");
+    SDL_free(mapping);
+
+    SDLTest_AssertCheck(SDL_GameControllerAddMappingsFromRW(NULL, 1) == -1, "SDL_GameControllerAddMappingsFromRW(NULL) fails");
+
+    SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Joystick routine test cases */
@@ -82,9 +144,14 @@ static const SDLTest_TestCaseReference joystickTest1 = {
     (SDLTest_TestCaseFp)TestVirtualJoystick, "TestVirtualJoystick", "Test virtual joystick functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference joystickTest2 = {
+    (SDLTest_TestCaseFp)TestControllerMappingsFromRW, "TestControllerMappingsFromRW", "Test loading a controller mapping database twice", TEST_ENABLED
+};
+
 /* Sequence of Joystick routine test cases */
 static const SDLTest_TestCaseReference *joystickTests[] = {
     &joystickTest1,
+    &joystickTest2,
     NULL
 };
 
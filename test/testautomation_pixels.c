@@ -169,6 +169,14 @@ int pixels_allocFreeFormat(void *arg)
                 SDLTest_AssertCheck(masks > 0, "Verify value of result.[RGBA]mask combined; expected: >0, got %" SDL_PRIu32, masks);
             }
 
+            /* Non-indexed formats are shared, like in SDL2 */
+            if (!SDL_ISPIXELFORMAT_INDEXED(format)) {
+                SDL_PixelFormat *result2 = SDL_AllocFormat(format);
+                SDLTest_AssertPass("Call to SDL_AllocFormat()");
+                SDLTest_AssertCheck(result2 == result, "Verify the same format is returned; expected: %p, got %p", (void *)result, (void *)result2);
+                SDL_FreeFormat(result2);
+            }
+
             /* Deallocate again */
             SDL_FreeFormat(result);
             SDLTest_AssertPass("Call to SDL_FreeFormat()");
@@ -469,6 +477,155 @@ pixels_calcGammaRamp(void *arg)
   return TEST_COMPLETED;
 }
 
+/* Index of the first palette entry nearest to r,g,b */
+static Uint32 _findNearestColor(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b)
+{
+    Uint32 best = 0;
+    Uint32 bestDistance = ~0u;
+    int i;
+
+    for (i = 0; i < palette->ncolors; i++) {
+        const int rd = (int)palette->colors[i].r - r;
+        const int gd = (int)palette->colors[i].g - g;
+        const int bd = (int)palette->colors[i].b - b;
+        const Uint32 distance = (Uint32)(rd * rd + gd * gd + bd * bd);
+        if (distance < bestDistance) {
+            best = (Uint32)i;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Check SDL_MapRGB against a brute force nearest color search on an indexed format
+ *
+ * @sa http://wiki.libsdl.org/SDL_MapRGB
+ * @sa http://wiki.libsdl.org/SDL_SetPaletteColors
+ */
+int pixels_mapRGBIndexed(void *arg)
+{
+    SDL_PixelFormat *format;
+    SDL_Palette *palette;
+    SDL_Color colors[16];
+    int pass, i, mismatches;
+
+    format = SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertPass("Call to SDL_AllocFormat(SDL_PIXELFORMAT_INDEX8)");
+    SDLTest_AssertCheck(format != NULL, "Verify result is not NULL");
+    palette = SDL_AllocPalette(SDL_arraysize(colors));
+    SDLTest_AssertPass("Call to SDL_AllocPalette(%d)", (int)SDL_arraysize(colors));
+    SDLTest_AssertCheck(palette != NULL, "Verify result is not NULL");
+    if (format == NULL || palette == NULL) {
+        SDL_FreePalette(palette);
+        SDL_FreeFormat(format);
+        return TEST_ABORTED;
+    }
+    SDL_SetPixelFormatPalette(format, palette);
+    SDLTest_AssertPass("Call to SDL_SetPixelFormatPalette()");
+
+    /* Later passes change the palette, so stale lookups would show up as mismatches.
+       The last one writes the colors directly and bumps the version, like some apps do. */
+    for (pass = 0; pass < 3; pass++) {
+        for (i = 0; i < (int)SDL_arraysize(colors); i++) {
+            colors[i].r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            colors[i].g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            colors[i].b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+        if (pass < 2) {
+            SDL_SetPaletteColors(palette, colors, 0, SDL_arraysize(colors));
+            SDLTest_AssertPass("Call to SDL_SetPaletteColors()");
+        } else {
+            SDL_memcpy(palette->colors, colors, sizeof(colors));
+            palette->version++;
+        }
+
+        mismatches = 0;
+        for (i = 0; i < 4096; i++) {
+            const Uint8 r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            const Uint8 g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            const Uint8 b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+            const Uint32 expected = _findNearestColor(palette, r, g, b);
+            Uint32 result = SDL_MapRGB(format, r, g, b);
+            if (result != expected) {
+                /* Equally near palette entries may legitimately differ; compare the colors */
+                const SDL_Color *c1 = &palette->colors[result];
+                const SDL_Color *c2 = &palette->colors[expected];
+                if (c1->r != c2->r || c1->g != c2->g || c1->b != c2->b) {
+                    mismatches++;
+                }
+            }
+            result = SDL_MapRGBA(format, r, g, b, SDL_ALPHA_OPAQUE);
+            if (palette->colors[result].r != palette->colors[expected].r ||
+                palette->colors[result].g != palette->colors[expected].g ||
+                palette->colors[result].b != palette->colors[expected].b) {
+                mismatches++;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify SDL_MapRGB/SDL_MapRGBA match the nearest palette color (pass %d); expected: 0 mismatches, got: %d", pass, mismatches);
+    }
+
+    SDL_FreeFormat(format);
+    SDLTest_AssertPass("Call to SDL_FreeFormat()");
+    SDL_FreePalette(palette);
+    SDLTest_AssertPass("Call to SDL_FreePalette()");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Round trip colors through SDL_MapRGBA and SDL_GetRGBA on the 32-bit formats
+ *
+ * @sa http://wiki.libsdl.org/SDL_GetRGB
+ * @sa http://wiki.libsdl.org/SDL_GetRGBA
+ */
+int pixels_getRGBA(void *arg)
+{
+    static const Uint32 formats[] = {
+        SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGBX8888, SDL_PIXELFORMAT_BGRX8888,
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888
+    };
+    SDL_PixelFormat *format;
+    Uint8 r, g, b, a, r2, g2, b2, a2;
+    Uint32 pixel;
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(formats); i++) {
+        format = SDL_AllocFormat(formats[i]);
+        SDLTest_AssertPass("Call to SDL_AllocFormat(%s)", SDL_GetPixelFormatName(formats[i]));
+        SDLTest_AssertCheck(format != NULL, "Verify result is not NULL");
+        if (format == NULL) {
+            continue;
+        }
+
+        r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        a = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+        pixel = SDL_MapRGBA(format, r, g, b, a);
+        SDLTest_AssertCheck(((pixel & format->Rmask) >> format->Rshift) == r, "Verify red is stored at Rmask");
+
+        SDL_GetRGB(pixel, format, &r2, &g2, &b2);
+        SDLTest_AssertPass("Call to SDL_GetRGB()");
+        SDLTest_AssertCheck(r2 == r && g2 == g && b2 == b,
+                            "Verify SDL_GetRGB result; expected: %u,%u,%u, got: %u,%u,%u", r, g, b, r2, g2, b2);
+
+        SDL_GetRGBA(pixel, format, &r2, &g2, &b2, &a2);
+        SDLTest_AssertPass("Call to SDL_GetRGBA()");
+        if (format->Amask == 0) {
+            a = SDL_ALPHA_OPAQUE;
+        }
+        SDLTest_AssertCheck(r2 == r && g2 == g && b2 == b && a2 == a,
+                            "Verify SDL_GetRGBA result; expected: %u,%u,%u,%u, got: %u,%u,%u,%u", r, g, b, a, r2, g2, b2, a2);
+
+        SDL_FreeFormat(format);
+        SDLTest_AssertPass("Call to SDL_FreeFormat()");
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -486,9 +643,15 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_mapRGBIndexed, "pixels_mapRGBIndexed", "Call to SDL_MapRGB and SDL_MapRGBA on an indexed format", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference pixelsTest6 =
+        { (SDLTest_TestCaseFp)pixels_getRGBA, "pixels_getRGBA", "Call to SDL_GetRGB and SDL_GetRGBA on 32-bit formats", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, NULL
 };
 
 /* Pixels test suite (global) */
@@ -941,6 +941,159 @@ int render_testGetSetTextureScaleMode(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * @brief Draws a mix of SDL_RenderCopy calls and other draws, and reads the result back. Helper function.
+ */
+static SDL_Surface *
+_renderSprites(void)
+{
+    SDL_Texture *tface;
+    SDL_Surface *result;
+    SDL_Rect srcrect, dstrect, fillrect;
+    SDL_FRect fdstrect;
+    int i, tw, th;
+    int checkFailCount = 0;
+
+    _clearScreen();
+
+    tface = _loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify _loadTestFace() result");
+    if (tface == NULL) {
+        return NULL;
+    }
+    SDL_QueryTexture(tface, NULL, NULL, &tw, &th);
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+
+    for (i = 0; i < 64; ++i) {
+        /* Runs of sprites from different parts of the texture, some hanging off its edges. */
+        srcrect.x = (i % 8) * 6 - 8;
+        srcrect.y = (i / 8) * 5 - 6;
+        srcrect.w = tw / 2;
+        srcrect.h = th / 2;
+        dstrect.x = (i * 7) % TESTRENDER_SCREEN_W - 8;
+        dstrect.y = (i * 5) % TESTRENDER_SCREEN_H - 8;
+        dstrect.w = 16 + (i % 3) * 4;
+        dstrect.h = 12 + (i % 5) * 3;
+        if (SDL_RenderCopy(renderer, tface, &srcrect, &dstrect) != 0) {
+            checkFailCount++;
+        }
+
+        fdstrect.x = dstrect.x + 0.5f;
+        fdstrect.y = dstrect.y + 0.25f;
+        fdstrect.w = (float)tw / 3.0f;
+        fdstrect.h = (float)th / 3.0f;
+        if (SDL_RenderCopyF(renderer, tface, NULL, &fdstrect) != 0) {
+            checkFailCount++;
+        }
+
+        /* Things that have to land in order with the sprites. */
+        if ((i % 16) == 15) {
+            SDL_SetTextureColorMod(tface, (Uint8)(i * 4), 255, (Uint8)(255 - i * 4));
+            SDL_SetTextureAlphaMod(tface, (Uint8)(128 + i));
+        }
+        if ((i % 10) == 9) {
+            fillrect.x = i % TESTRENDER_SCREEN_W;
+            fillrect.y = i % TESTRENDER_SCREEN_H;
+            fillrect.w = 10;
+            fillrect.h = 10;
+            SDL_SetRenderDrawColor(renderer, (Uint8)(i * 3), 64, 32, SDL_ALPHA_OPAQUE);
+            SDL_RenderFillRect(renderer, &fillrect);
+        }
+    }
+    SDLTest_AssertCheck(checkFailCount == 0, "Validate results from calls to SDL_RenderCopy/SDL_RenderCopyF, expected: 0, got: %i", checkFailCount);
+
+    result = SDL_CreateRGBSurface(0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+    SDLTest_AssertCheck(result != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+    if (result != NULL) {
+        int ret = SDL_RenderReadPixels(renderer, NULL, RENDER_COMPARE_FORMAT, result->pixels, result->pitch);
+        SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+    }
+
+    SDL_DestroyTexture(tface);
+    return result;
+}
+
+/**
+ * @brief Tests that batched SDL_RenderCopy calls draw exactly what unbatched ones do.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL2/SDL_RenderCopy
+ * http://wiki.libsdl.org/SDL2/SDL_RenderCopyF
+ */
+int render_testBatchedCopy(void *arg)
+{
+    SDL_Surface *batched;
+    SDL_Surface *unbatched;
+    SDL_Surface *other_surface;
+    int renderer_flags = SDL_RENDERER_ACCELERATED;
+    int result;
+
+    if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") == 0) {
+        renderer_flags = 0;
+    }
+
+    /* Sprite batching is opt-in, so recreate the renderer with it. */
+    SDL_DestroyRenderer(renderer);
+    SDL_SetHint("SDL2COMPAT_SPRITE_BATCHING", "1");
+    renderer = SDL_CreateRenderer(window, -1, renderer_flags);
+    SDL_ResetHint("SDL2COMPAT_SPRITE_BATCHING");
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result");
+    if (renderer == NULL) {
+        return TEST_ABORTED;
+    }
+
+    batched = _renderSprites();
+    SDLTest_AssertCheck(SDL_RenderFlush(renderer) == 0, "Validate result from SDL_RenderFlush, expected: 0");
+
+    /* A texture from another renderer has to be rejected right away, not batched and dropped later. */
+    other_surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(other_surface != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+    if (other_surface) {
+        SDL_Renderer *other_renderer = SDL_CreateSoftwareRenderer(other_surface);
+        SDLTest_AssertCheck(other_renderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+        if (other_renderer) {
+            SDL_Texture *other_texture = SDL_CreateTexture(other_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+            SDLTest_AssertCheck(other_texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+            if (other_texture) {
+                SDL_Rect dst = { 0, 0, 16, 16 };
+                SDL_FRect fdst = { 0.0f, 0.0f, 16.0f, 16.0f };
+                result = SDL_RenderCopy(renderer, other_texture, NULL, &dst);
+                SDLTest_AssertCheck(result == -1, "Validate result from SDL_RenderCopy with another renderer's texture, expected: -1, got: %i", result);
+                result = SDL_RenderCopyF(renderer, other_texture, NULL, &fdst);
+                SDLTest_AssertCheck(result == -1, "Validate result from SDL_RenderCopyF with another renderer's texture, expected: -1, got: %i", result);
+                SDL_DestroyTexture(other_texture);
+            }
+            SDL_DestroyRenderer(other_renderer);
+        }
+        SDL_FreeSurface(other_surface);
+    }
+    result = SDL_RenderFlush(renderer);
+    SDLTest_AssertCheck(result == 0, "Validate result from SDL_RenderFlush after rejected copies, expected: 0, got: %i", result);
+
+    /* Recreate the same renderer without sprite batching for the reference image. */
+    SDL_DestroyRenderer(renderer);
+    SDL_SetHint("SDL2COMPAT_SPRITE_BATCHING", "0");
+    renderer = SDL_CreateRenderer(window, -1, renderer_flags);
+    SDL_ResetHint("SDL2COMPAT_SPRITE_BATCHING");
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result");
+    if (renderer == NULL) {
+        SDL_FreeSurface(batched);
+        return TEST_ABORTED;
+    }
+
+    unbatched = _renderSprites();
+
+    if (batched && unbatched) {
+        result = SDLTest_CompareSurfaces(batched, unbatched, ALLOWABLE_ERROR_OPAQUE);
+        SDLTest_AssertCheck(result == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", result);
+    }
+
+    SDL_FreeSurface(batched);
+    SDL_FreeSurface(unbatched);
+    return TEST_COMPLETED;
+}
+
 /**
  * @brief Checks to see if functionality is supported. Helper function.
  */
@@ -1299,9 +1452,13 @@ static const SDLTest_TestCaseReference renderTest9 = {
     (SDLTest_TestCaseFp)render_testRGBSurfaceNoAlpha, "render_testRGBSurfaceNoAlpha", "Tests RGB surface with no alpha using software renderer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testBatchedCopy, "render_testBatchedCopy", "Tests that batched SDL_RenderCopy calls match unbatched ones", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, NULL
 };
 
 /* Render test suite (global) */
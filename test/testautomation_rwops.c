@@ -24,6 +24,8 @@
 const char *RWopsReadTestFilename = "rwops_read";
 const char *RWopsWriteTestFilename = "rwops_write";
 const char *RWopsAlphabetFilename = "rwops_alphabet";
+const char *RWopsLargeFilename = "rwops_large";
+const char *RWopsEmptyFilename = "rwops_empty";
 
 static const char RWopsHelloWorldTestString[] = "Hello World!";
 static const char RWopsHelloWorldCompString[] = "Hello World!";
@@ -42,6 +44,8 @@ void RWopsSetUp(void *arg)
     (void)remove(RWopsReadTestFilename);
     (void)remove(RWopsWriteTestFilename);
     (void)remove(RWopsAlphabetFilename);
+    (void)remove(RWopsLargeFilename);
+    (void)remove(RWopsEmptyFilename);
 
     /* Create a test file */
     handle = fopen(RWopsReadTestFilename, "w");
@@ -311,19 +315,25 @@ int rwops_testFileRead(void)
     }
 
     /* Check type */
+    if (SDL_GetHintBoolean("SDL2COMPAT_RWFROMFILE_MMAP", SDL_FALSE)) {
+        SDLTest_AssertCheck(
+            rw->type == SDL_RWOPS_MEMORY_RO,
+            "Verify RWops type of a mapped file is SDL_RWOPS_MEMORY_RO; expected: %d, got: %" SDL_PRIu32, SDL_RWOPS_MEMORY_RO, rw->type);
+    } else {
 #if defined(__ANDROID__)
-    SDLTest_AssertCheck(
-        rw->type == SDL_RWOPS_STDFILE || rw->type == SDL_RWOPS_JNIFILE,
-        "Verify RWops type is SDL_RWOPS_STDFILE or SDL_RWOPS_JNIFILE; expected: %d|%d, got: %d", SDL_RWOPS_STDFILE, SDL_RWOPS_JNIFILE, rw->type);
+        SDLTest_AssertCheck(
+            rw->type == SDL_RWOPS_STDFILE || rw->type == SDL_RWOPS_JNIFILE,
+            "Verify RWops type is SDL_RWOPS_STDFILE or SDL_RWOPS_JNIFILE; expected: %d|%d, got: %d", SDL_RWOPS_STDFILE, SDL_RWOPS_JNIFILE, rw->type);
 #elif defined(__WIN32__)
-    SDLTest_AssertCheck(
-        rw->type == SDL_RWOPS_WINFILE,
-        "Verify RWops type is SDL_RWOPS_WINFILE; expected: %d, got: %d", SDL_RWOPS_WINFILE, rw->type);
+        SDLTest_AssertCheck(
+            rw->type == SDL_RWOPS_WINFILE,
+            "Verify RWops type is SDL_RWOPS_WINFILE; expected: %d, got: %d", SDL_RWOPS_WINFILE, rw->type);
 #else
-    SDLTest_AssertCheck(
-        rw->type == SDL_RWOPS_STDFILE,
-        "Verify RWops type is SDL_RWOPS_STDFILE; expected: %d, got: %" SDL_PRIu32, SDL_RWOPS_STDFILE, rw->type);
+        SDLTest_AssertCheck(
+            rw->type == SDL_RWOPS_STDFILE,
+            "Verify RWops type is SDL_RWOPS_STDFILE; expected: %d, got: %" SDL_PRIu32, SDL_RWOPS_STDFILE, rw->type);
 #endif
+    }
 
     /* Run generic tests */
     _testGenericRWopsValidations(rw, 0);
@@ -707,6 +717,578 @@ int rwops_testFileWriteReadEndian(void)
     return TEST_COMPLETED;
 }
 
+/* An app-style RWops that counts the calls SDL makes into it. */
+typedef struct RWopsCounter
+{
+    SDL_RWops *mem;
+    int reads;
+    int writes;
+    SDL_bool no_size;
+    SDL_bool fail_writes;
+    SDL_bool forward_only;
+} RWopsCounter;
+
+static Sint64 SDLCALL counter_size(SDL_RWops *rw)
+{
+    RWopsCounter *counter = (RWopsCounter *)rw->hidden.unknown.data1;
+    return counter->no_size ? -1 : SDL_RWsize(counter->mem);
+}
+
+static Sint64 SDLCALL counter_seek(SDL_RWops *rw, Sint64 offset, int whence)
+{
+    RWopsCounter *counter = (RWopsCounter *)rw->hidden.unknown.data1;
+    if (counter->forward_only) {
+        /* like a pipe: it knows its position, but can only skip ahead. */
+        const Sint64 pos = SDL_RWtell(counter->mem);
+        if ((whence == RW_SEEK_CUR && offset < 0) || (whence == RW_SEEK_SET && offset < pos) || whence == RW_SEEK_END) {
+            return SDL_SetError("counter_seek can't go back");
+        }
+    }
+    return SDL_RWseek(counter->mem, offset, whence);
+}
+
+static size_t SDLCALL counter_read(SDL_RWops *rw, void *ptr, size_t size, size_t maxnum)
+{
+    RWopsCounter *counter = (RWopsCounter *)rw->hidden.unknown.data1;
+    counter->reads++;
+    return SDL_RWread(counter->mem, ptr, size, maxnum);
+}
+
+static size_t SDLCALL counter_write(SDL_RWops *rw, const void *ptr, size_t size, size_t num)
+{
+    RWopsCounter *counter = (RWopsCounter *)rw->hidden.unknown.data1;
+    counter->writes++;
+    if (counter->fail_writes) {
+        SDL_SetError("counter_write failed");
+        return 0;
+    }
+    return SDL_RWwrite(counter->mem, ptr, size, num);
+}
+
+static int SDLCALL counter_close(SDL_RWops *rw)
+{
+    SDL_FreeRW(rw);
+    return 0;
+}
+
+/**
+ * @brief Tests that SDL reading and writing through an app's RWops leaves it where unbuffered access would.
+ *
+ * \sa http://wiki.libsdl.org/SDL_SaveBMP_RW
+ * \sa http://wiki.libsdl.org/SDL_LoadBMP_RW
+ */
+int rwops_testAppRWops(void)
+{
+    static Uint8 direct[8192];
+    static Uint8 counted[8192];
+    RWopsCounter counter;
+    SDL_RWops *rw;
+    SDL_RWops *mem;
+    SDL_Surface *surface;
+    Sint64 direct_size, counted_size, direct_pos, counted_pos;
+    char tail[5] = { 0 };
+    int result;
+    int i;
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_FillRect(surface, NULL, 0x80402010);
+
+    /* Save through a plain memory RWops and through the counting one. */
+    SDL_memset(direct, 0, sizeof(direct));
+    SDL_memset(counted, 0, sizeof(counted));
+    mem = SDL_RWFromMem(direct, sizeof(direct));
+    result = SDL_SaveBMP_RW(surface, mem, 0);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SaveBMP_RW() to memory result; expected: 0, got: %d", result);
+    direct_size = SDL_RWtell(mem);
+    SDL_RWwrite(mem, "TAIL", 1, 4);
+    SDL_RWclose(mem);
+
+    SDL_zero(counter);
+    counter.mem = SDL_RWFromMem(counted, sizeof(counted));
+    rw = SDL_AllocRW();
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_AllocRW() result is not NULL");
+    if (rw == NULL || counter.mem == NULL) {
+        SDL_FreeSurface(surface);
+        return TEST_ABORTED;
+    }
+    rw->size = counter_size;
+    rw->seek = counter_seek;
+    rw->read = counter_read;
+    rw->write = counter_write;
+    rw->close = counter_close;
+    rw->hidden.unknown.data1 = &counter;
+
+    result = SDL_SaveBMP_RW(surface, rw, 0);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SaveBMP_RW() to app RWops result; expected: 0, got: %d", result);
+    counted_size = SDL_RWtell(rw);
+    SDLTest_AssertCheck(counted_size == direct_size, "Verify position after save; expected: %d, got: %d", (int)direct_size, (int)counted_size);
+    SDLTest_AssertCheck(SDL_memcmp(direct, counted, (size_t)direct_size) == 0, "Verify saved data matches");
+    SDLTest_AssertCheck(counter.writes < surface->h, "Verify writes were combined; expected fewer than %d, got: %d", surface->h, counter.writes);
+    SDL_RWwrite(rw, "TAIL", 1, 4);
+
+    /* Load back, the RWops must end up right after the image, as if nothing read ahead. */
+    mem = SDL_RWFromMem(direct, sizeof(direct));
+    SDL_FreeSurface(SDL_LoadBMP_RW(mem, 0));
+    direct_pos = SDL_RWtell(mem);
+    SDL_RWclose(mem);
+
+    /* Twice, to check that whatever SDL keeps for the RWops between calls starts where the app left it. */
+    for (i = 0; i < 2; i++) {
+        SDL_RWseek(rw, 0, RW_SEEK_SET);
+        SDL_FreeSurface(surface);
+        surface = SDL_LoadBMP_RW(rw, 0);
+        SDLTest_AssertCheck(surface != NULL, "Verify SDL_LoadBMP_RW() from app RWops is not NULL");
+        counted_pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(counted_pos == direct_pos, "Verify position after load; expected: %d, got: %d", (int)direct_pos, (int)counted_pos);
+        if (counted_pos == direct_size) {
+            SDL_RWread(rw, tail, 1, 4);
+            SDLTest_AssertCheck(SDL_strcmp(tail, "TAIL") == 0, "Verify data after the image; expected: TAIL, got: %s", tail);
+        }
+    }
+
+    SDL_FreeSurface(surface);
+    SDL_RWclose(rw);
+    SDL_RWclose(counter.mem);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_LoadFile_RW() on app RWops, with and without a size.
+ *
+ * \sa http://wiki.libsdl.org/SDL_LoadFile_RW
+ */
+int rwops_testLoadFileAppRWops(void)
+{
+    static Uint8 source[10000];
+    RWopsCounter counter;
+    SDL_RWops *rw;
+    Uint8 *data;
+    size_t datasize;
+    int i;
+
+    for (i = 0; i < (int)sizeof(source); i++) {
+        source[i] = (Uint8)(i * 7);
+    }
+
+    for (i = 0; i < 2; i++) {
+        SDL_zero(counter);
+        counter.mem = SDL_RWFromConstMem(source, sizeof(source));
+        counter.no_size = (i == 1) ? SDL_TRUE : SDL_FALSE;
+        rw = SDL_AllocRW();
+        SDLTest_AssertCheck(rw != NULL, "Verify SDL_AllocRW() result is not NULL");
+        if (rw == NULL || counter.mem == NULL) {
+            return TEST_ABORTED;
+        }
+        rw->size = counter_size;
+        rw->seek = counter_seek;
+        rw->read = counter_read;
+        rw->write = counter_write;
+        rw->close = counter_close;
+        rw->hidden.unknown.data1 = &counter;
+
+        /* start partway in, SDL_LoadFile_RW() reads from the current position. */
+        SDL_RWseek(rw, 100, RW_SEEK_SET);
+        datasize = 0;
+        data = (Uint8 *)SDL_LoadFile_RW(rw, &datasize, 1);
+        SDLTest_AssertPass("Call to SDL_LoadFile_RW(), %s size", counter.no_size ? "without" : "with");
+        SDLTest_AssertCheck(data != NULL, "Verify result is not NULL");
+        SDLTest_AssertCheck(datasize == sizeof(source) - 100, "Verify size; expected: %d, got: %d", (int)sizeof(source) - 100, (int)datasize);
+        if (data) {
+            SDLTest_AssertCheck(SDL_memcmp(data, source + 100, sizeof(source) - 100) == 0, "Verify data matches");
+            SDLTest_AssertCheck(data[datasize] == '\0', "Verify data is null-terminated");
+        }
+        if (!counter.no_size) {
+            SDLTest_AssertCheck(counter.reads == 2, "Verify data was read at once; expected: 2 reads, got: %d", counter.reads);
+        }
+        SDL_free(data);
+        SDL_RWclose(counter.mem);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that a failed write to an app RWops fails the call, even when SDL buffered it until the end.
+ *
+ * \sa http://wiki.libsdl.org/SDL_SaveBMP_RW
+ */
+int rwops_testAppRWopsWriteFailure(void)
+{
+    static Uint8 buffer[8192];
+    RWopsCounter counter;
+    SDL_RWops *rw;
+    SDL_Surface *surface;
+    int result;
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+
+    SDL_zero(counter);
+    counter.mem = SDL_RWFromMem(buffer, sizeof(buffer));
+    counter.fail_writes = SDL_TRUE;
+    rw = SDL_AllocRW();
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_AllocRW() result is not NULL");
+    if (rw == NULL || counter.mem == NULL) {
+        SDL_FreeSurface(surface);
+        return TEST_ABORTED;
+    }
+    rw->size = counter_size;
+    rw->seek = counter_seek;
+    rw->read = counter_read;
+    rw->write = counter_write;
+    rw->close = counter_close;
+    rw->hidden.unknown.data1 = &counter;
+
+    /* the whole image fits in the bridge buffer, so the only write happens after SDL3 thinks it's done. */
+    result = SDL_SaveBMP_RW(surface, rw, 0);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SaveBMP_RW() to a failing RWops result; expected: -1, got: %d", result);
+    SDLTest_AssertCheck(counter.writes > 0, "Verify the RWops was written to; got: %d writes", counter.writes);
+    SDLTest_AssertCheck(*SDL_GetError() != '\0', "Verify an error was set");
+
+    /* and the next call through the same RWops starts clean. */
+    counter.fail_writes = SDL_FALSE;
+    SDL_RWseek(rw, 0, RW_SEEK_SET);
+    result = SDL_SaveBMP_RW(surface, rw, 1);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SaveBMP_RW() after the failure result; expected: 0, got: %d", result);
+
+    SDL_FreeSurface(surface);
+    SDL_RWclose(counter.mem);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests loading from an app RWops that reports its position but can't seek back.
+ *
+ * \sa http://wiki.libsdl.org/SDL_LoadBMP_RW
+ */
+int rwops_testForwardOnlyAppRWops(void)
+{
+    static Uint8 buffer[8192];
+    RWopsCounter counter;
+    SDL_RWops *rw;
+    SDL_RWops *mem;
+    SDL_Surface *surface;
+    Sint64 size, pos;
+    char tail[5] = { 0 };
+    int i;
+
+    surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(surface != NULL, "Verify surface is not NULL");
+    if (surface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_FillRect(surface, NULL, 0x80402010);
+    mem = SDL_RWFromMem(buffer, sizeof(buffer));
+    SDL_SaveBMP_RW(surface, mem, 0);
+    size = SDL_RWtell(mem);
+    SDL_RWwrite(mem, "TAIL", 1, 4);
+    SDL_RWclose(mem);
+    SDL_FreeSurface(surface);
+
+    /* Twice, to check that the bridge kept for the RWops between calls doesn't start reading ahead. */
+    for (i = 0; i < 2; i++) {
+        SDL_zero(counter);
+        counter.mem = SDL_RWFromConstMem(buffer, sizeof(buffer));
+        counter.forward_only = SDL_TRUE;
+        rw = SDL_AllocRW();
+        SDLTest_AssertCheck(rw != NULL, "Verify SDL_AllocRW() result is not NULL");
+        if (rw == NULL || counter.mem == NULL) {
+            return TEST_ABORTED;
+        }
+        rw->size = counter_size;
+        rw->seek = counter_seek;
+        rw->read = counter_read;
+        rw->write = counter_write;
+        rw->close = counter_close;
+        rw->hidden.unknown.data1 = &counter;
+
+        surface = SDL_LoadBMP_RW(rw, 0);
+        SDLTest_AssertCheck(surface != NULL, "Verify SDL_LoadBMP_RW() from a forward-only RWops is not NULL: %s", surface ? "" : SDL_GetError());
+        pos = SDL_RWtell(rw);
+        SDLTest_AssertCheck(pos == size, "Verify position after load; expected: %d, got: %d", (int)size, (int)pos);
+        SDL_RWread(rw, tail, 1, 4);
+        SDLTest_AssertCheck(SDL_strcmp(tail, "TAIL") == 0, "Verify data after the image; expected: TAIL, got: %s", tail);
+        SDL_FreeSurface(surface);
+        SDL_RWclose(rw);
+        SDL_RWclose(counter.mem);
+    }
+    return TEST_COMPLETED;
+}
+
+/* Writes RWopsLargeFilename with a pattern, and returns what it wrote. */
+static Uint8 *_createLargeTestFile(size_t size)
+{
+    Uint8 *data;
+    SDL_RWops *rw;
+    size_t written;
+    int i;
+
+    data = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(data != NULL, "Verify allocation of %d bytes", (int)size);
+    if (data == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < (int)size; i++) {
+        data[i] = (Uint8)((i * 31) ^ (i >> 11));
+    }
+    rw = SDL_RWFromFile(RWopsLargeFilename, "wb");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file '%s' in write mode does not return NULL", RWopsLargeFilename);
+    if (rw == NULL) {
+        SDL_free(data);
+        return NULL;
+    }
+    written = SDL_RWwrite(rw, data, 1, size);
+    SDL_RWclose(rw);
+    SDLTest_AssertCheck(written == size, "Verify number of written bytes; expected: %d, got: %d", (int)size, (int)written);
+    return data;
+}
+
+/**
+ * @brief Compares random reads and seeks on a file bigger than sdl2-compat's file buffers with the same on memory.
+ *
+ * \sa http://wiki.libsdl.org/SDL_RWFromFile
+ * \sa http://wiki.libsdl.org/SDL_RWFromConstMem
+ */
+static int _testLargeFileReads(void)
+{
+    const size_t size = 1536 * 1024 + 123;  /* past the read-ahead buffer and the prefetch window. */
+    static Uint8 buffer_file[300000];
+    static Uint8 buffer_mem[300000];
+    Uint8 *data;
+    SDL_RWops *rw;
+    SDL_RWops *mem;
+    int result;
+    int i;
+
+    data = _createLargeTestFile(size);
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+
+    rw = SDL_RWFromFile(RWopsLargeFilename, "rb");
+    mem = SDL_RWFromConstMem(data, (int)size);
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file '%s' in read mode does not return NULL", RWopsLargeFilename);
+    if (rw == NULL || mem == NULL) {
+        if (rw) {
+            SDL_RWclose(rw);
+        }
+        if (mem) {
+            SDL_RWclose(mem);
+        }
+        SDL_free(data);
+        (void)remove(RWopsLargeFilename);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(SDL_RWsize(rw) == (Sint64)size, "Verify SDL_RWsize(); expected: %d, got: %d", (int)size, (int)SDL_RWsize(rw));
+
+    for (i = 0; i < 500; i++) {
+        const int op = SDLTest_RandomIntegerInRange(0, 9);
+        Sint64 pos_file, pos_mem;
+
+        if (op == 0) {
+            const Sint64 offset = SDLTest_RandomIntegerInRange(0, (Sint32)size - 1);
+            pos_file = SDL_RWseek(rw, offset, RW_SEEK_SET);
+            pos_mem = SDL_RWseek(mem, offset, RW_SEEK_SET);
+        } else if (op == 1) {
+            /* short skips, like parsers do, in both directions. */
+            const Sint64 offset = SDLTest_RandomIntegerInRange(-100, 100);
+            if (SDL_RWtell(mem) + offset < 0 || SDL_RWtell(mem) + offset > (Sint64)size) {
+                continue;
+            }
+            pos_file = SDL_RWseek(rw, offset, RW_SEEK_CUR);
+            pos_mem = SDL_RWseek(mem, offset, RW_SEEK_CUR);
+        } else {
+            /* mostly small reads, sometimes one bigger than any of the buffers. */
+            const size_t amount = (size_t)((op == 2) ? SDLTest_RandomIntegerInRange(1, (Sint32)sizeof(buffer_file)) : SDLTest_RandomIntegerInRange(1, 64));
+            const size_t read_file = SDL_RWread(rw, buffer_file, 1, amount);
+            const size_t read_mem = SDL_RWread(mem, buffer_mem, 1, amount);
+            SDLTest_AssertCheck(read_file == read_mem, "Verify read of %d bytes; expected: %d, got: %d", (int)amount, (int)read_mem, (int)read_file);
+            if (read_file == read_mem && SDL_memcmp(buffer_file, buffer_mem, read_file) != 0) {
+                SDLTest_AssertCheck(SDL_FALSE, "Verify read of %d bytes matches memory", (int)amount);
+                break;
+            }
+            pos_file = SDL_RWtell(rw);
+            pos_mem = SDL_RWtell(mem);
+        }
+        if (pos_file != pos_mem) {
+            SDLTest_AssertCheck(SDL_FALSE, "Verify position after operation %d; expected: %d, got: %d", op, (int)pos_mem, (int)pos_file);
+            break;
+        }
+    }
+
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    SDL_RWclose(mem);
+    SDL_free(data);
+    (void)remove(RWopsLargeFilename);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests reading an empty file, and seeking past the end of a file.
+ *
+ * \sa http://wiki.libsdl.org/SDL_RWFromFile
+ * \sa http://wiki.libsdl.org/SDL_RWseek
+ */
+static int _testFileEnds(void)
+{
+    const Sint64 size = (Sint64)SDL_strlen(RWopsAlphabetString);
+    char buf[4];
+    SDL_RWops *rw;
+    FILE *handle;
+    Sint64 pos;
+    size_t s;
+    int result;
+
+    handle = fopen(RWopsEmptyFilename, "w");
+    SDLTest_AssertCheck(handle != NULL, "Verify creation of file '%s' returned non NULL handle", RWopsEmptyFilename);
+    if (handle == NULL) {
+        return TEST_ABORTED;
+    }
+    fclose(handle);
+
+    rw = SDL_RWFromFile(RWopsEmptyFilename, "rb");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening an empty file does not return NULL");
+    if (rw != NULL) {
+        pos = SDL_RWsize(rw);
+        SDLTest_AssertCheck(pos == 0, "Verify SDL_RWsize() of an empty file; expected: 0, got: %d", (int)pos);
+        s = SDL_RWread(rw, buf, 1, sizeof(buf));
+        SDLTest_AssertCheck(s == 0, "Verify SDL_RWread() from an empty file; expected: 0, got: %d", (int)s);
+        pos = SDL_RWseek(rw, 0, RW_SEEK_END);
+        SDLTest_AssertCheck(pos == 0, "Verify SDL_RWseek(0, RW_SEEK_END) in an empty file; expected: 0, got: %d", (int)pos);
+        result = SDL_RWclose(rw);
+        SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    }
+    (void)remove(RWopsEmptyFilename);
+
+    rw = SDL_RWFromFile(RWopsAlphabetFilename, "rb");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file '%s' does not return NULL", RWopsAlphabetFilename);
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    pos = SDL_RWseek(rw, size + 100, RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == size + 100, "Verify seek past the end; expected: %d, got: %d", (int)(size + 100), (int)pos);
+    s = SDL_RWread(rw, buf, 1, sizeof(buf));
+    SDLTest_AssertCheck(s == 0, "Verify SDL_RWread() past the end; expected: 0, got: %d", (int)s);
+    pos = SDL_RWtell(rw);
+    SDLTest_AssertCheck(pos == size + 100, "Verify position after reading past the end; expected: %d, got: %d", (int)(size + 100), (int)pos);
+    pos = SDL_RWseek(rw, -1, RW_SEEK_SET);
+    SDLTest_AssertCheck(pos == -1, "Verify seek before the start fails; expected: -1, got: %d", (int)pos);
+    pos = SDL_RWseek(rw, -2, RW_SEEK_END);
+    SDLTest_AssertCheck(pos == size - 2, "Verify seek back from past the end; expected: %d, got: %d", (int)(size - 2), (int)pos);
+    s = SDL_RWread(rw, buf, 1, sizeof(buf));
+    SDLTest_AssertCheck(s == 2 && buf[0] == 'Y' && buf[1] == 'Z', "Verify the last bytes read after seeking back; expected: 2, got: %d", (int)s);
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
+/* Runs the file read tests with one of sdl2-compat's SDL_RWFromFile() hints set. */
+static int _testFileBackend(const char *hint)
+{
+    int result;
+
+    SDL_SetHint(hint, "1");
+    SDLTest_AssertPass("Call to SDL_SetHint(%s, 1)", hint);
+    result = rwops_testFileRead();
+    if (result == TEST_COMPLETED) {
+        result = rwops_testCompareRWFromMemWithRWFromFile();
+    }
+    if (result == TEST_COMPLETED) {
+        result = _testLargeFileReads();
+    }
+    if (result == TEST_COMPLETED) {
+        result = _testFileEnds();
+    }
+    SDL_ResetHint(hint);
+    return result;
+}
+
+/**
+ * @brief Tests file reads and seeks through sdl2-compat's read-ahead buffer.
+ */
+int rwops_testFileReadAhead(void)
+{
+    return _testFileBackend("SDL2COMPAT_RWFROMFILE_READAHEAD");
+}
+
+/**
+ * @brief Tests file reads and seeks on memory mapped files.
+ */
+int rwops_testFileMapped(void)
+{
+    return _testFileBackend("SDL2COMPAT_RWFROMFILE_MMAP");
+}
+
+/**
+ * @brief Tests file reads and seeks with background prefetch, and closing files while prefetches are pending.
+ */
+int rwops_testFilePrefetch(void)
+{
+    const size_t size = 4 * 1024 * 1024;
+    Uint8 buf[16];
+    Uint8 *data;
+    SDL_RWops *rw;
+    Sint64 pos;
+    size_t s;
+    int result;
+    int i;
+
+    result = _testFileBackend("SDL2COMPAT_RWFROMFILE_PREFETCH");
+    if (result != TEST_COMPLETED) {
+        return result;
+    }
+
+    data = _createLargeTestFile(size);
+    if (data == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetHint("SDL2COMPAT_RWFROMFILE_PREFETCH", "1");
+    for (i = 0; i < 20; i++) {
+        rw = SDL_RWFromFile(RWopsLargeFilename, "rb");
+        SDLTest_AssertCheck(rw != NULL, "Verify opening file '%s' does not return NULL", RWopsLargeFilename);
+        if (rw == NULL) {
+            break;
+        }
+        /* prefetching starts at open, so these all close with reads in flight. */
+        if (i % 4 == 1) {
+            s = SDL_RWread(rw, buf, 1, sizeof(buf));
+            SDLTest_AssertCheck(s == sizeof(buf) && SDL_memcmp(buf, data, sizeof(buf)) == 0, "Verify read from the start; expected: %d bytes, got: %d", (int)sizeof(buf), (int)s);
+        } else if (i % 4 == 2) {
+            /* moving away leaves the pending reads to be dropped when they finish. */
+            pos = SDL_RWseek(rw, (Sint64)size - 1000, RW_SEEK_SET);
+            s = SDL_RWread(rw, buf, 1, sizeof(buf));
+            SDLTest_AssertCheck(pos == (Sint64)size - 1000 && s == sizeof(buf) && SDL_memcmp(buf, data + size - 1000, sizeof(buf)) == 0,
+                                "Verify read near the end; expected: %d bytes, got: %d", (int)sizeof(buf), (int)s);
+        } else if (i % 4 == 3) {
+            SDL_RWseek(rw, (Sint64)size / 2, RW_SEEK_SET);
+        }
+        result = SDL_RWclose(rw);
+        SDLTest_AssertCheck(result == 0, "Verify closing with prefetches pending; expected: 0, got: %d", result);
+    }
+    SDL_ResetHint("SDL2COMPAT_RWFROMFILE_PREFETCH");
+
+    SDL_free(data);
+    (void)remove(RWopsLargeFilename);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests reading an empty file and seeking past the end of a file, without any of sdl2-compat's hints.
+ */
+int rwops_testFileEnds(void)
+{
+    return _testFileEnds();
+}
+
 /* ================= Test References ================== */
 
 /* RWops test cases */
@@ -745,10 +1327,36 @@ static const SDLTest_TestCaseReference rwopsTest9 =
 static const SDLTest_TestCaseReference rwopsTest10 =
         { (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference rwopsTest11 =
+        { (SDLTest_TestCaseFp)rwops_testAppRWops, "rwops_testAppRWops", "Test SDL reading and writing through an app RWops", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest12 =
+        { (SDLTest_TestCaseFp)rwops_testLoadFileAppRWops, "rwops_testLoadFileAppRWops", "Test SDL_LoadFile_RW with an app RWops", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest13 =
+        { (SDLTest_TestCaseFp)rwops_testAppRWopsWriteFailure, "rwops_testAppRWopsWriteFailure", "Test that failed buffered writes to an app RWops are reported", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest14 =
+        { (SDLTest_TestCaseFp)rwops_testForwardOnlyAppRWops, "rwops_testForwardOnlyAppRWops", "Test loading from an app RWops that can't seek back", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest15 =
+        { (SDLTest_TestCaseFp)rwops_testFileReadAhead, "rwops_testFileReadAhead", "Test reading from a file with SDL2COMPAT_RWFROMFILE_READAHEAD", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest16 =
+        { (SDLTest_TestCaseFp)rwops_testFileMapped, "rwops_testFileMapped", "Test reading from a file with SDL2COMPAT_RWFROMFILE_MMAP", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest17 =
+        { (SDLTest_TestCaseFp)rwops_testFileEnds, "rwops_testFileEnds", "Test reading an empty file and seeking past the end of a file", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest18 =
+        { (SDLTest_TestCaseFp)rwops_testFilePrefetch, "rwops_testFilePrefetch", "Test reading from a file with SDL2COMPAT_RWFROMFILE_PREFETCH", TEST_ENABLED };
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] = {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11, &rwopsTest12,
+    &rwopsTest13, &rwopsTest14, &rwopsTest15, &rwopsTest16,
+    &rwopsTest17, &rwopsTest18, NULL
 };
 
 /* RWops test suite (global) */
@@ -843,6 +843,322 @@ static int surface_testSetGetClipRect(void *args)
     return TEST_COMPLETED;
 };
 
+/**
+ * Tests that changes the application makes to a surface between blits are picked up.
+ */
+static int surface_testBlitAfterChanges(void *arg)
+{
+    SDL_Surface *src, *dst;
+    SDL_Palette *palette;
+    SDL_Color color;
+    Uint8 pixels[2] = { 0, 1 };
+    Uint8 *original_pixels;
+    Uint32 pixel;
+    int ret;
+
+    src = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 8, SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+    dst = SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(dst != NULL, "Verify destination surface is not NULL");
+    if (!src || !dst) {
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return TEST_ABORTED;
+    }
+
+    color.r = 255;
+    color.g = 0;
+    color.b = 0;
+    color.a = 255;
+    SDL_SetPaletteColors(src->format->palette, &color, 0, 1);
+    color.r = 0;
+    color.b = 255;
+    SDL_SetPaletteColors(src->format->palette, &color, 1, 1);
+    *(Uint8 *)src->pixels = 0;
+
+    ret = SDL_BlitSurface(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    pixel = *(Uint32 *)dst->pixels;
+    SDLTest_AssertCheck(pixel == 0xFFFF0000, "Verify blitted pixel, expected: 0xFFFF0000, got: 0x%.8" SDL_PRIx32, pixel);
+
+    /* Change the palette colors */
+    color.r = 0;
+    color.g = 255;
+    color.b = 0;
+    SDL_SetPaletteColors(src->format->palette, &color, 0, 1);
+    ret = SDL_BlitSurface(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    pixel = *(Uint32 *)dst->pixels;
+    SDLTest_AssertCheck(pixel == 0xFF00FF00, "Verify blitted pixel after palette change, expected: 0xFF00FF00, got: 0x%.8" SDL_PRIx32, pixel);
+
+    /* Swap the pixels out from under the surface, like SDL_ttf does */
+    original_pixels = (Uint8 *)src->pixels;
+    src->pixels = &pixels[1];
+    ret = SDL_BlitSurface(src, NULL, dst, NULL);
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    pixel = *(Uint32 *)dst->pixels;
+    SDLTest_AssertCheck(pixel == 0xFF0000FF, "Verify blitted pixel after changing pixels, expected: 0xFF0000FF, got: 0x%.8" SDL_PRIx32, pixel);
+    src->pixels = original_pixels;
+
+    /* Replace the palette */
+    palette = SDL_AllocPalette(256);
+    SDLTest_AssertCheck(palette != NULL, "Verify palette is not NULL");
+    if (palette) {
+        color.r = 255;
+        color.g = 255;
+        color.b = 255;
+        SDL_SetPaletteColors(palette, &color, 0, 1);
+        SDL_SetSurfacePalette(src, palette);
+        SDL_FreePalette(palette);
+        ret = SDL_BlitSurface(src, NULL, dst, NULL);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+        pixel = *(Uint32 *)dst->pixels;
+        SDLTest_AssertCheck(pixel == 0xFFFFFFFF, "Verify blitted pixel after new palette, expected: 0xFFFFFFFF, got: 0x%.8" SDL_PRIx32, pixel);
+    }
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    return TEST_COMPLETED;
+}
+
+typedef int (SDLCALL *BlitSurfacesFn)(SDL_Surface *src, const SDL_Rect *srcrects, SDL_Surface *dst, SDL_Rect *dstrects, int count);
+
+/**
+ * Tests that the sdl2-compat batched blit matches individual blits.
+ */
+static int surface_testBlitSurfaces(void *arg)
+{
+    BlitSurfacesFn BlitSurfaces = (BlitSurfacesFn)SDL_GL_GetProcAddress("SDL2Compat_BlitSurfaces");
+    SDL_Surface *src, *dst1, *dst2;
+    SDL_Rect srcrects[64], dstrects1[64], dstrects2[64];
+    SDL_Rect clip;
+    int i, ret, mismatches;
+
+    if (!BlitSurfaces) {
+        SDLTest_Log("SDL2Compat_BlitSurfaces not available, skipping");
+        return TEST_SKIPPED;
+    }
+
+    src = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888);
+    dst1 = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    dst2 = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDLTest_AssertCheck(src && dst1 && dst2, "Verify surfaces are not NULL");
+    if (!src || !dst1 || !dst2) {
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst1);
+        SDL_FreeSurface(dst2);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < src->w * src->h; i++) {
+        ((Uint32 *)src->pixels)[i] = (Uint32)SDLTest_RandomUint32() | 0xFF000000;
+    }
+    clip.x = 4;
+    clip.y = 4;
+    clip.w = 50;
+    clip.h = 50;
+    SDL_SetClipRect(dst1, &clip);
+    SDL_SetClipRect(dst2, &clip);
+
+    /* Rects are partly outside the source and the clip rect, some entirely */
+    for (i = 0; i < (int)SDL_arraysize(srcrects); i++) {
+        srcrects[i].x = SDLTest_RandomIntegerInRange(-8, 40);
+        srcrects[i].y = SDLTest_RandomIntegerInRange(-8, 40);
+        srcrects[i].w = SDLTest_RandomIntegerInRange(0, 20);
+        srcrects[i].h = SDLTest_RandomIntegerInRange(0, 20);
+        dstrects1[i].x = SDLTest_RandomIntegerInRange(-16, 72);
+        dstrects1[i].y = SDLTest_RandomIntegerInRange(-16, 72);
+        dstrects1[i].w = 0;
+        dstrects1[i].h = 0;
+    }
+    SDL_memcpy(dstrects2, dstrects1, sizeof(dstrects1));
+
+    for (i = 0; i < (int)SDL_arraysize(srcrects); i++) {
+        ret = SDL_BlitSurface(src, &srcrects[i], dst1, &dstrects1[i]);
+        SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface, expected: 0, got: %i", ret);
+    }
+    ret = BlitSurfaces(src, srcrects, dst2, dstrects2, SDL_arraysize(srcrects));
+    SDLTest_AssertCheck(ret == 0, "Verify result from SDL2Compat_BlitSurfaces, expected: 0, got: %i", ret);
+
+    mismatches = 0;
+    for (i = 0; i < (int)SDL_arraysize(srcrects); i++) {
+        if (SDL_memcmp(&dstrects1[i], &dstrects2[i], sizeof(SDL_Rect)) != 0) {
+            mismatches++;
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Verify updated destination rects match; expected: 0 mismatches, got: %d", mismatches);
+    ret = SDL_memcmp(dst1->pixels, dst2->pixels, (size_t)dst1->pitch * dst1->h);
+    SDLTest_AssertCheck(ret == 0, "Verify blitted pixels match");
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst1);
+    SDL_FreeSurface(dst2);
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that a surface reusing a freed surface's struct comes back reset.
+ */
+static int surface_testPooledSurfaceReset(void *arg)
+{
+    SDL_Surface *surface;
+    SDL_Rect clip;
+    Uint32 key;
+    Uint8 r, g, b, a;
+    int i, ret;
+
+    for (i = 0; i < 4; i++) {
+        surface = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurfaceWithFormat is not NULL");
+        if (!surface) {
+            return TEST_ABORTED;
+        }
+
+        /* every surface after the first should be the one freed just before it. */
+        SDLTest_AssertCheck(surface->userdata == NULL, "Verify userdata is NULL");
+        SDLTest_AssertCheck(surface->refcount == 1, "Verify refcount; expected: 1, got: %d", surface->refcount);
+        SDLTest_AssertCheck(surface->locked == 0, "Verify locked; expected: 0, got: %d", surface->locked);
+        SDL_GetClipRect(surface, &clip);
+        SDLTest_AssertCheck(clip.x == 0 && clip.y == 0 && clip.w == 32 && clip.h == 32,
+                            "Verify clip rect; expected: 0,0 32x32, got: %d,%d %dx%d", clip.x, clip.y, clip.w, clip.h);
+        ret = SDL_GetColorKey(surface, &key);
+        SDLTest_AssertCheck(ret == -1, "Verify SDL_GetColorKey result; expected: -1, got: %d", ret);
+        SDL_GetSurfaceColorMod(surface, &r, &g, &b);
+        SDL_GetSurfaceAlphaMod(surface, &a);
+        SDLTest_AssertCheck(r == 255 && g == 255 && b == 255 && a == 255, "Verify color and alpha mods are reset");
+
+        /* dirty everything, then free it so the next surface can reuse its struct. */
+        surface->userdata = &clip;
+        clip.x = 3;
+        clip.y = 5;
+        clip.w = 7;
+        clip.h = 9;
+        SDL_SetClipRect(surface, &clip);
+        SDL_SetColorKey(surface, SDL_TRUE, 0x12345678);
+        SDL_SetSurfaceColorMod(surface, 1, 2, 3);
+        SDL_SetSurfaceAlphaMod(surface, 4);
+        surface->refcount++;
+        SDL_FreeSurface(surface);
+        SDL_FreeSurface(surface);
+    }
+    return TEST_COMPLETED;
+}
+
+/* Counts the ways two conversions of the same surface differ. */
+static int _compareConvertedSurfaces(SDL_Surface *fast, SDL_Surface *slow)
+{
+    SDL_BlendMode fast_blend, slow_blend;
+    Uint32 fast_key = 0, slow_key = 0;
+    Uint8 fast_mod[4], slow_mod[4];
+    int differences = 0;
+    int y;
+
+    if (fast->format->format != slow->format->format || fast->w != slow->w || fast->h != slow->h) {
+        return 1;
+    }
+    for (y = 0; y < fast->h; y++) {
+        if (SDL_memcmp((Uint8 *)fast->pixels + y * fast->pitch, (Uint8 *)slow->pixels + y * slow->pitch, (size_t)fast->w * fast->format->BytesPerPixel) != 0) {
+            differences++;
+        }
+    }
+    if ((fast->format->palette != NULL) != (slow->format->palette != NULL)) {
+        differences++;
+    } else if (fast->format->palette) {
+        if (fast->format->palette->ncolors != slow->format->palette->ncolors ||
+            SDL_memcmp(fast->format->palette->colors, slow->format->palette->colors, fast->format->palette->ncolors * sizeof(SDL_Color)) != 0) {
+            differences++;
+        }
+        if (fast->format->palette == slow->format->palette) {
+            differences++;  /* each conversion gets its own palette. */
+        }
+    }
+    if (SDL_GetColorKey(fast, &fast_key) != SDL_GetColorKey(slow, &slow_key) || fast_key != slow_key) {
+        differences++;
+    }
+    SDL_GetSurfaceBlendMode(fast, &fast_blend);
+    SDL_GetSurfaceBlendMode(slow, &slow_blend);
+    if (fast_blend != slow_blend) {
+        differences++;
+    }
+    SDL_GetSurfaceColorMod(fast, &fast_mod[0], &fast_mod[1], &fast_mod[2]);
+    SDL_GetSurfaceAlphaMod(fast, &fast_mod[3]);
+    SDL_GetSurfaceColorMod(slow, &slow_mod[0], &slow_mod[1], &slow_mod[2]);
+    SDL_GetSurfaceAlphaMod(slow, &slow_mod[3]);
+    if (SDL_memcmp(fast_mod, slow_mod, sizeof(fast_mod)) != 0) {
+        differences++;
+    }
+    return differences;
+}
+
+/**
+ * Tests that same-format conversions copied by sdl2-compat match SDL3's conversion.
+ */
+static int surface_testConvertByCopy(void *arg)
+{
+    const Uint32 formats[] = { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 };
+    int f, variant;
+
+    for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+        /* variants: plain, color key, color and alpha mod, blend mode changed, all of them. */
+        for (variant = 0; variant < 5; variant++) {
+            SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, 13, 7, 0, formats[f]);
+            SDL_Surface *fast[2], *slow[2];
+            int i, y;
+
+            SDLTest_AssertCheck(src != NULL, "Verify SDL_CreateRGBSurfaceWithFormat(%s) is not NULL", SDL_GetPixelFormatName(formats[f]));
+            if (!src) {
+                return TEST_ABORTED;
+            }
+            if (src->format->palette) {
+                SDL_Color colors[256];
+                for (i = 0; i < 256; i++) {
+                    colors[i].r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[i].g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[i].b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[i].a = SDL_ALPHA_OPAQUE;
+                }
+                SDL_SetPaletteColors(src->format->palette, colors, 0, 256);
+            }
+            for (y = 0; y < src->h; y++) {
+                Uint8 *row = (Uint8 *)src->pixels + y * src->pitch;
+                for (i = 0; i < src->w * src->format->BytesPerPixel; i++) {
+                    row[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                }
+            }
+            if (variant == 1 || variant == 4) {
+                SDL_SetColorKey(src, SDL_TRUE, *(Uint8 *)src->pixels);
+            }
+            if (variant == 2 || variant == 4) {
+                SDL_SetSurfaceColorMod(src, 10, 20, 30);
+                SDL_SetSurfaceAlphaMod(src, 128);
+            }
+            if (variant == 3 || variant == 4) {
+                SDL_SetSurfaceBlendMode(src, SDL_ISPIXELFORMAT_ALPHA(formats[f]) ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+            }
+
+            fast[0] = SDL_ConvertSurface(src, src->format, 0);
+            fast[1] = SDL_ConvertSurfaceFormat(src, formats[f], 0);
+            SDL_SetHint("SDL2COMPAT_CONVERT_BY_COPY", "0");
+            slow[0] = SDL_ConvertSurface(src, src->format, 0);
+            slow[1] = SDL_ConvertSurfaceFormat(src, formats[f], 0);
+            SDL_ResetHint("SDL2COMPAT_CONVERT_BY_COPY");
+
+            for (i = 0; i < 2; i++) {
+                SDLTest_AssertCheck(fast[i] != NULL && slow[i] != NULL, "Verify conversions are not NULL");
+                if (fast[i] && slow[i]) {
+                    const int differences = _compareConvertedSurfaces(fast[i], slow[i]);
+                    SDLTest_AssertCheck(differences == 0, "Verify %s of %s (variant %d) matches SDL3; expected: 0 differences, got: %d",
+                                        i ? "SDL_ConvertSurfaceFormat" : "SDL_ConvertSurface", SDL_GetPixelFormatName(formats[f]), variant, differences);
+                }
+                SDL_FreeSurface(fast[i]);
+                SDL_FreeSurface(slow[i]);
+            }
+            SDL_FreeSurface(src);
+        }
+    }
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -905,13 +1221,30 @@ static const SDLTest_TestCaseReference surfaceTestSetGetClipRect = {
     surface_testSetGetClipRect, "surface_testSetGetClipRect", "Test SDL_(Set|Get)ClipRect.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitAfterChanges = {
+    surface_testBlitAfterChanges, "surface_testBlitAfterChanges", "Test blitting after changing the surface between blits.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitSurfaces = {
+    surface_testBlitSurfaces, "surface_testBlitSurfaces", "Test SDL2Compat_BlitSurfaces against SDL_BlitSurface.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPooledSurfaceReset = {
+    surface_testPooledSurfaceReset, "surface_testPooledSurfaceReset", "Test that reused surface structs come back reset.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestConvertByCopy = {
+    surface_testConvertByCopy, "surface_testConvertByCopy", "Test same-format conversions against SDL3's conversion.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
     &surfaceTest11, &surfaceTest12, &surfaceTestOverflow,
-    &surfaceTestSetGetClipRect,
-    NULL
+    &surfaceTestSetGetClipRect, &surfaceTestBlitAfterChanges,
+    &surfaceTestBlitSurfaces, &surfaceTestPooledSurfaceReset,
+    &surfaceTestConvertByCopy, NULL
 };
 
 /* Surface test suite (global) */
@@ -2288,6 +2288,265 @@ static int video_setWindowInputFocus(void *arg)
     return TEST_COMPLETED;
 }
 
+/* SDL3 keeps the mask made by SDL_SetWindowShape() as an ARGB32 surface in the "SDL.window.shape" window
+   property, which SDL_GetWindowData() can see. SDL3's SDL_Surface starts with these fields. */
+typedef struct
+{
+    Uint32 flags;
+    Uint32 format;
+    int w;
+    int h;
+    int pitch;
+    void *pixels;
+} _ShapeMaskSurface;
+
+static Uint32 _readShapePixel(const SDL_Surface *surface, int x, int y)
+{
+    const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+    switch (surface->format->BytesPerPixel) {
+    case 1:
+        return row[x];
+    case 2:
+        return ((const Uint16 *)row)[x];
+    default:
+        return ((const Uint32 *)row)[x];
+    }
+}
+
+static void _writeShapePixel(SDL_Surface *surface, int x, int y, Uint32 pixel)
+{
+    Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+    switch (surface->format->BytesPerPixel) {
+    case 1:
+        row[x] = (Uint8)pixel;
+        break;
+    case 2:
+        ((Uint16 *)row)[x] = (Uint16)pixel;
+        break;
+    default:
+        ((Uint32 *)row)[x] = pixel;
+        break;
+    }
+}
+
+/* The mask value for one pixel, the way the generic per-pixel path works it out. */
+static Uint32 _expectedShapeMask(const SDL_WindowShapeMode *mode, const SDL_Surface *surface, Uint32 pixel)
+{
+    Uint8 r, g, b, a;
+    SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &a);
+    switch (mode->mode) {
+    case ShapeModeDefault:
+        return (a >= 1) ? 0xFFFFFFFF : 0;
+    case ShapeModeBinarizeAlpha:
+        return (a >= mode->parameters.binarizationCutoff) ? 0xFFFFFFFF : 0;
+    case ShapeModeReverseBinarizeAlpha:
+        return (a <= mode->parameters.binarizationCutoff) ? 0xFFFFFFFF : 0;
+    default:
+        return (r != mode->parameters.colorKey.r || g != mode->parameters.colorKey.g || b != mode->parameters.colorKey.b) ? 0xFFFFFFFF : 0;
+    }
+}
+
+/**
+ * Tests that each specialized shape mask path matches the generic per-pixel one
+ */
+static int video_setWindowShapeMask(void *arg)
+{
+    const Uint32 formats[] = {
+        SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_RGB332,                                      /* 8-bit table */
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888,         /* 32-bit alpha and color key */
+        SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888,                                  /* 32-bit without alpha */
+        SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB4444                                     /* generic */
+    };
+    const int widths[] = { 1, 7, 13, 64 };
+    const WindowShapeMode modes[] = { ShapeModeDefault, ShapeModeBinarizeAlpha, ShapeModeReverseBinarizeAlpha, ShapeModeColorKey };
+    const int h = 5;
+    SDL_Window *window;
+    int f, wi, m, x, y;
+
+    window = SDL_CreateShapedWindow("video_setWindowShapeMask", 0, 0, 64, h, 0);
+    SDLTest_AssertPass("Call to SDL_CreateShapedWindow()");
+    if (!window) {
+        SDLTest_Log("Shaped windows aren't supported here: %s", SDL_GetError());
+        return TEST_SKIPPED;
+    }
+
+    for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+        for (wi = 0; wi < (int)SDL_arraysize(widths); wi++) {
+            const int w = widths[wi];
+            SDL_Surface *shape = SDL_CreateRGBSurfaceWithFormat(0, w, h, 0, formats[f]);
+            SDLTest_AssertCheck(shape != NULL, "Verify SDL_CreateRGBSurfaceWithFormat(%s) is not NULL", SDL_GetPixelFormatName(formats[f]));
+            if (!shape) {
+                continue;
+            }
+            if (shape->format->palette) {
+                SDL_Color colors[256];
+                for (x = 0; x < 256; x++) {
+                    colors[x].r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[x].g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[x].b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                    colors[x].a = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                }
+                SDL_SetPaletteColors(shape->format->palette, colors, 0, 256);
+            }
+            for (y = 0; y < h; y++) {
+                for (x = 0; x < w; x++) {
+                    _writeShapePixel(shape, x, y, (Uint32)SDLTest_RandomUint32());
+                }
+            }
+            /* every third pixel repeats the first one, so color key mode has matches in every format. */
+            for (y = 0; y < h; y++) {
+                for (x = 0; x < w; x++) {
+                    if (((y * w + x) % 3) == 0) {
+                        _writeShapePixel(shape, x, y, _readShapePixel(shape, 0, 0));
+                    }
+                }
+            }
+
+            for (m = 0; m < (int)SDL_arraysize(modes); m++) {
+                SDL_WindowShapeMode mode;
+                const _ShapeMaskSurface *mask;
+                int result, mismatches = 0;
+
+                SDL_zero(mode);
+                mode.mode = modes[m];
+                if (mode.mode == ShapeModeColorKey) {
+                    Uint8 a;
+                    SDL_GetRGBA(_readShapePixel(shape, 0, 0), shape->format, &mode.parameters.colorKey.r, &mode.parameters.colorKey.g, &mode.parameters.colorKey.b, &a);
+                } else {
+                    mode.parameters.binarizationCutoff = (Uint8)SDLTest_RandomIntegerInRange(1, 254);
+                }
+
+                result = SDL_SetWindowShape(window, shape, &mode);
+                SDLTest_AssertCheck(result == 0, "Verify SDL_SetWindowShape() result; expected: 0, got: %d", result);
+                mask = (const _ShapeMaskSurface *)SDL_GetWindowData(window, "SDL.window.shape");
+                if (result != 0 || !mask || mask->w != w || mask->h != h) {
+                    SDLTest_AssertCheck(mask != NULL, "Verify the shape mask is available");
+                    continue;
+                }
+
+                for (y = 0; y < h; y++) {
+                    const Uint32 *row = (const Uint32 *)((const Uint8 *)mask->pixels + y * mask->pitch);
+                    for (x = 0; x < w; x++) {
+                        if (row[x] != _expectedShapeMask(&mode, shape, _readShapePixel(shape, x, y))) {
+                            mismatches++;
+                        }
+                    }
+                }
+                SDLTest_AssertCheck(mismatches == 0, "Verify shape mask for %s, width %d, mode %d; expected: 0 mismatches, got: %d",
+                                    SDL_GetPixelFormatName(formats[f]), w, (int)mode.mode, mismatches);
+            }
+            SDL_FreeSurface(shape);
+        }
+    }
+
+    SDL_DestroyWindow(window);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests setting gamma ramps and brightness with SDL2COMPAT_EMULATE_GAMMA, and reading them back.
+ *
+ * @sa http://wiki.libsdl.org/SDL_SetWindowGammaRamp
+ * @sa http://wiki.libsdl.org/SDL_GetWindowGammaRamp
+ * @sa http://wiki.libsdl.org/SDL_SetWindowBrightness
+ */
+int video_setWindowGammaRamp(void *arg)
+{
+    const char *title = "video_setWindowGammaRamp Test Window";
+    const float brightness = 0.5f;
+    Uint16 set[3][256];
+    Uint16 got[3][256];
+    Uint16 expected[256];
+    SDL_Window *window;
+    SDL_Surface *surface;
+    float result_brightness;
+    int result;
+    int i;
+
+    window = _createVideoSuiteTestWindow(title);
+    if (!window) {
+        return TEST_ABORTED;
+    }
+
+    /* SDL3 has no gamma ramps, so without the hint setting one fails. */
+    SDL_SetHint("SDL2COMPAT_EMULATE_GAMMA", "0");
+    SDL_CalculateGammaRamp(1.0f, set[0]);
+    result = SDL_SetWindowGammaRamp(window, set[0], set[0], set[0]);
+    SDLTest_AssertCheck(result == -1, "Verify SDL_SetWindowGammaRamp() without emulation; expected: -1, got: %d", result);
+
+    SDL_SetHint("SDL2COMPAT_EMULATE_GAMMA", "1");
+
+    /* a different ramp per channel, so a mixed up channel shows. */
+    for (i = 0; i < 256; i++) {
+        set[0][i] = (Uint16)(i * 256);
+        set[1][i] = (Uint16)((255 - i) * 256);
+        set[2][i] = (Uint16)(i * 128);
+    }
+    result = SDL_SetWindowGammaRamp(window, set[0], set[1], set[2]);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetWindowGammaRamp(r,g,b); expected: 0, got: %d", result);
+    result = SDL_GetWindowGammaRamp(window, got[0], got[1], got[2]);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_GetWindowGammaRamp(r,g,b); expected: 0, got: %d", result);
+    for (i = 0; i < 3; i++) {
+        SDLTest_AssertCheck(SDL_memcmp(set[i], got[i], sizeof(set[i])) == 0, "Verify channel %d of the gamma ramp reads back", i);
+    }
+
+    /* NULL leaves a channel alone. */
+    result = SDL_SetWindowGammaRamp(window, NULL, set[0], NULL);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetWindowGammaRamp(NULL,g,NULL); expected: 0, got: %d", result);
+    SDL_GetWindowGammaRamp(window, got[0], got[1], got[2]);
+    SDLTest_AssertCheck(SDL_memcmp(set[0], got[0], sizeof(set[0])) == 0 &&
+                        SDL_memcmp(set[0], got[1], sizeof(set[0])) == 0 &&
+                        SDL_memcmp(set[2], got[2], sizeof(set[2])) == 0, "Verify only the green channel changed");
+
+    result = SDL_SetWindowBrightness(window, brightness);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetWindowBrightness(%f); expected: 0, got: %d", brightness, result);
+    result_brightness = SDL_GetWindowBrightness(window);
+    SDLTest_AssertCheck(result_brightness == brightness, "Verify SDL_GetWindowBrightness(); expected: %f, got: %f", brightness, result_brightness);
+    SDL_CalculateGammaRamp(brightness, expected);
+    SDL_GetWindowGammaRamp(window, got[0], got[1], got[2]);
+    for (i = 0; i < 3; i++) {
+        SDLTest_AssertCheck(SDL_memcmp(expected, got[i], sizeof(expected)) == 0, "Verify channel %d of the gamma ramp matches the brightness", i);
+    }
+
+    /* the ramps are applied while presenting, but the app keeps its own pixels. */
+    surface = SDL_GetWindowSurface(window);
+    if (surface && surface->format->BytesPerPixel == 4) {
+        const Uint32 color = SDL_MapRGB(surface->format, 0x80, 0x40, 0x20);
+        SDL_Rect rect;
+        int mismatches = 0;
+        int x, y;
+
+        SDL_FillRect(surface, NULL, color);
+        result = SDL_UpdateWindowSurface(window);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_UpdateWindowSurface(); expected: 0, got: %d", result);
+        rect.x = 1;
+        rect.y = 1;
+        rect.w = surface->w / 2;
+        rect.h = surface->h / 2;
+        result = SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+        SDLTest_AssertCheck(result == 0, "Verify SDL_UpdateWindowSurfaceRects(); expected: 0, got: %d", result);
+        for (y = 0; y < surface->h; y++) {
+            const Uint32 *row = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < surface->w; x++) {
+                if (row[x] != color) {
+                    mismatches++;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify the surface pixels are unchanged after presenting; expected: 0 changed, got: %d", mismatches);
+    }
+
+    /* back to normal. */
+    result = SDL_SetWindowBrightness(window, 1.0f);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_SetWindowBrightness(1.0); expected: 0, got: %d", result);
+    result_brightness = SDL_GetWindowBrightness(window);
+    SDLTest_AssertCheck(result_brightness == 1.0f, "Verify SDL_GetWindowBrightness(); expected: 1.0, got: %f", result_brightness);
+
+    SDL_ResetHint("SDL2COMPAT_EMULATE_GAMMA");
+    _destroyVideoSuiteTestWindow(window);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Video test cases */
@@ -2378,6 +2637,13 @@ static const SDLTest_TestCaseReference videoTest25 = {
 static const SDLTest_TestCaseReference videoTest26 = {
     (SDLTest_TestCaseFp)video_setWindowInputFocus, "video_setWindowInputFocus", "Checks window input focus", TEST_ENABLED
 };
+static const SDLTest_TestCaseReference videoTest27 = {
+    (SDLTest_TestCaseFp)video_setWindowShapeMask, "video_setWindowShapeMask", "Checks the shape mask for each pixel format path against the generic one", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference videoTest28 = {
+    (SDLTest_TestCaseFp)video_setWindowGammaRamp, "video_setWindowGammaRamp", "Checks gamma ramps and brightness read back with SDL2COMPAT_EMULATE_GAMMA", TEST_ENABLED
+};
 
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] = {
@@ -2385,7 +2651,8 @@ static const SDLTest_TestCaseReference *videoTests[] = {
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
     &videoTest18, &videoTest19, &videoTest20, &videoTest21, &videoTest22,
-    &videoTest23, &videoTest24, &videoTest25, &videoTest26, NULL
+    &videoTest23, &videoTest24, &videoTest25, &videoTest26, &videoTest27,
+    &videoTest28, NULL
 };
 
 /* Video test suite (global) */
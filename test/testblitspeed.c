@@ -0,0 +1,132 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times lots of small SDL_BlitSurface() calls, the way tile and sprite engines use them.
+   Usage: testblitspeed [iterations] */
+
+#include "SDL.h"
+
+#define SCREEN_W 640
+#define SCREEN_H 480
+#define TILE_SIZE 16
+
+static SDL_Surface *CreateTile(Uint32 format)
+{
+    SDL_Surface *tile = SDL_CreateRGBSurfaceWithFormat(0, TILE_SIZE, TILE_SIZE, 0, format);
+    int x, y;
+
+    if (!tile) {
+        return NULL;
+    }
+    if (tile->format->palette) {
+        SDL_Color colors[256];
+        for (x = 0; x < 256; x++) {
+            colors[x].r = (Uint8)x;
+            colors[x].g = (Uint8)(255 - x);
+            colors[x].b = (Uint8)(x * 7);
+            colors[x].a = SDL_ALPHA_OPAQUE;
+        }
+        SDL_SetPaletteColors(tile->format->palette, colors, 0, 256);
+    }
+    SDL_LockSurface(tile);
+    for (y = 0; y < TILE_SIZE; y++) {
+        Uint8 *row = (Uint8 *)tile->pixels + y * tile->pitch;
+        for (x = 0; x < TILE_SIZE * tile->format->BytesPerPixel; x++) {
+            row[x] = (Uint8)(x * 31 + y * 17);
+        }
+    }
+    SDL_UnlockSurface(tile);
+    return tile;
+}
+
+static void TimeBlits(const char *name, SDL_Surface *tile, SDL_Surface *screen, int iterations)
+{
+    const int columns = SCREEN_W / TILE_SIZE;
+    const int rows = SCREEN_H / TILE_SIZE;
+    Uint64 start, elapsed;
+    SDL_Rect dst;
+    int i;
+
+    dst.w = TILE_SIZE;
+    dst.h = TILE_SIZE;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        dst.x = (i % columns) * TILE_SIZE;
+        dst.y = ((i / columns) % rows) * TILE_SIZE;
+        SDL_BlitSurface(tile, NULL, screen, &dst);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_Log("%-28s %d blits in %.2f ms, %.1f ns per blit",
+            name, iterations, (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency(),
+            (double)elapsed * 1e9 / SDL_GetPerformanceFrequency() / iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_Surface *screen;
+    SDL_Surface *tile;
+    int iterations = 1000000;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+        if (iterations <= 0) {
+            SDL_Log("Usage: %s [iterations]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    screen = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_W, SCREEN_H, 0, SDL_PIXELFORMAT_XRGB8888);
+    if (!screen) {
+        SDL_Log("Couldn't create screen surface: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    tile = CreateTile(SDL_PIXELFORMAT_XRGB8888);
+    if (tile) {
+        TimeBlits("XRGB8888 copy", tile, screen, iterations);
+        SDL_FreeSurface(tile);
+    }
+
+    tile = CreateTile(SDL_PIXELFORMAT_ARGB8888);
+    if (tile) {
+        SDL_SetSurfaceBlendMode(tile, SDL_BLENDMODE_BLEND);
+        TimeBlits("ARGB8888 blend", tile, screen, iterations);
+        SDL_FreeSurface(tile);
+    }
+
+    tile = CreateTile(SDL_PIXELFORMAT_INDEX8);
+    if (tile) {
+        SDL_SetColorKey(tile, SDL_TRUE, 0);
+        TimeBlits("INDEX8 color key", tile, screen, iterations);
+        SDL_FreeSurface(tile);
+    }
+
+    tile = CreateTile(SDL_PIXELFORMAT_RGB565);
+    if (tile) {
+        TimeBlits("RGB565 convert", tile, screen, iterations);
+        SDL_FreeSurface(tile);
+    }
+
+    SDL_FreeSurface(screen);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times loading a large gamecontrollerdb.txt with SDL_GameControllerAddMappingsFromFile(), then
+   loading it again, the way several libraries in one app each load the same database.
+   Usage: testcontrollerdbspeed [mappings per platform] */
+
+#include <stdio.h>
+
+#include "SDL.h"
+
+static const char *filename = "testcontrollerdbspeed.tmp";
+
+/* Writes mappings for this and a few other platforms, with comments and blank lines, like the real file. */
+static SDL_bool WriteDatabase(int count)
+{
+    const char *platforms[] = { "Windows", "Mac OS X", "Linux", "Android", "iOS" };
+    SDL_RWops *rw = SDL_RWFromFile(filename, "wb");
+    char line[512];
+    int p, i;
+
+    if (!rw) {
+        SDL_Log("Couldn't create %s: %s", filename, SDL_GetError());
+        return SDL_FALSE;
+    }
+    /* this platform first, then the ones that get skipped. */
+    for (p = -1; p < (int)SDL_arraysize(platforms); p++) {
+        const char *platform = (p < 0) ? SDL_GetPlatform() : platforms[p];
+        if (p >= 0 && SDL_strcmp(platform, SDL_GetPlatform()) == 0) {
+            continue;
+        }
+        SDL_snprintf(line, sizeof(line), "\n# %s\n", platform);
+        SDL_RWwrite(rw, line, 1, SDL_strlen(line));
+        for (i = 0; i < count; i++) {
+            SDL_snprintf(line, sizeof(line),
+                         "03000000%04x0000%08x00000000,Test Controller %d,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,"
+                         "guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,"
+                         "righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:%s,\n",
+                         p + 1, i, i, platform);
+            if (SDL_RWwrite(rw, line, 1, SDL_strlen(line)) != SDL_strlen(line)) {
+                SDL_Log("Couldn't write %s: %s", filename, SDL_GetError());
+                SDL_RWclose(rw);
+                return SDL_FALSE;
+            }
+        }
+    }
+    SDL_RWclose(rw);
+    return SDL_TRUE;
+}
+
+static void TimeLoad(const char *what)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const int added = SDL_GameControllerAddMappingsFromFile(filename);
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (added < 0) {
+        SDL_Log("Couldn't load %s: %s", filename, SDL_GetError());
+    } else {
+        SDL_Log("%-14s %d mappings added in %.2f ms", what, added, (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int count = 2000;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        count = SDL_atoi(argv[1]);
+        if (count <= 0 || count > 0xFFFF) {
+            SDL_Log("Usage: %s [mappings per platform, up to 65535]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(SDL_INIT_GAMECONTROLLER) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    if (!WriteDatabase(count)) {
+        SDL_Quit();
+        return 1;
+    }
+
+    TimeLoad("first load");
+    TimeLoad("second load");
+    TimeLoad("third load");
+
+    remove(filename);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times parsing a file a few bytes at a time through SDL_RWFromFile(), the way image and
+   level loaders do, with each of sdl2-compat's file hints set in turn.
+   Usage: testfilereadspeed [megabytes] */
+
+#include <stdio.h>
+
+#include "SDL.h"
+
+static const char *filename = "testfilereadspeed.tmp";
+
+static SDL_bool WriteTestFile(int megabytes)
+{
+    static Uint8 block[64 * 1024];
+    SDL_RWops *rw = SDL_RWFromFile(filename, "wb");
+    int i;
+
+    if (!rw) {
+        SDL_Log("Couldn't create %s: %s", filename, SDL_GetError());
+        return SDL_FALSE;
+    }
+    for (i = 0; i < (int)sizeof(block); i++) {
+        block[i] = (Uint8)(i * 31);
+    }
+    for (i = 0; i < megabytes * 16; i++) {
+        if (SDL_RWwrite(rw, block, sizeof(block), 1) != 1) {
+            SDL_Log("Couldn't write %s: %s", filename, SDL_GetError());
+            SDL_RWclose(rw);
+            return SDL_FALSE;
+        }
+    }
+    SDL_RWclose(rw);
+    return SDL_TRUE;
+}
+
+static void TimeReads(const char *hint)
+{
+    Uint64 start, elapsed;
+    Uint32 checksum = 0;
+    Uint64 total = 0;
+    SDL_RWops *rw;
+
+    if (hint) {
+        SDL_SetHint(hint, "1");
+    }
+
+    start = SDL_GetPerformanceCounter();
+    rw = SDL_RWFromFile(filename, "rb");
+    if (!rw) {
+        SDL_Log("Couldn't open %s: %s", filename, SDL_GetError());
+    } else {
+        Uint8 chunk[256];
+        for (;;) {
+            /* a small header, a length and a skip back over part of it, then the data it describes. */
+            const Uint32 value = SDL_ReadLE32(rw);
+            const size_t len = 16 + (value % 240);
+            size_t amount;
+
+            SDL_RWseek(rw, -2, RW_SEEK_CUR);
+            amount = SDL_RWread(rw, chunk, 1, len);
+            if (amount == 0) {
+                break;
+            }
+            checksum += value + chunk[amount - 1];
+            total += 4 + amount - 2;
+        }
+        SDL_RWclose(rw);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_Log("%-32s %" SDL_PRIu64 " bytes in %.2f ms (checksum %08" SDL_PRIx32 ")",
+            hint ? hint : "no hints", total, (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency(), checksum);
+
+    if (hint) {
+        SDL_ResetHint(hint);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int megabytes = 16;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        megabytes = SDL_atoi(argv[1]);
+        if (megabytes <= 0) {
+            SDL_Log("Usage: %s [megabytes]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    if (!WriteTestFile(megabytes)) {
+        SDL_Quit();
+        return 1;
+    }
+
+    /* once to get the file into the OS cache, so every run below reads from memory. */
+    TimeReads(NULL);
+    TimeReads(NULL);
+    TimeReads("SDL2COMPAT_RWFROMFILE_READAHEAD");
+    TimeReads("SDL2COMPAT_RWFROMFILE_MMAP");
+    TimeReads("SDL2COMPAT_RWFROMFILE_PREFETCH");
+
+    remove(filename);
+    SDL_Quit();
+    return 0;
+}
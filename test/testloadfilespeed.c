@@ -0,0 +1,156 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_LoadFile_RW() on an app's own RWops, with and without a size, next to an
+   SDL_RWFromConstMem() RWops, which SDL3 loads itself. The app RWops counts the reads it gets.
+   Usage: testloadfilespeed [iterations] */
+
+#include "SDL.h"
+
+typedef struct
+{
+    SDL_RWops *mem;
+    SDL_bool has_size;
+    int reads;
+} AppData;
+
+static Sint64 SDLCALL app_size(SDL_RWops *rw)
+{
+    AppData *app = (AppData *)rw->hidden.unknown.data1;
+    return app->has_size ? SDL_RWsize(app->mem) : -1;
+}
+
+static Sint64 SDLCALL app_seek(SDL_RWops *rw, Sint64 offset, int whence)
+{
+    return SDL_RWseek(((AppData *)rw->hidden.unknown.data1)->mem, offset, whence);
+}
+
+static size_t SDLCALL app_read(SDL_RWops *rw, void *ptr, size_t size, size_t maxnum)
+{
+    AppData *app = (AppData *)rw->hidden.unknown.data1;
+    app->reads++;
+    return SDL_RWread(app->mem, ptr, size, maxnum);
+}
+
+static size_t SDLCALL app_write(SDL_RWops *rw, const void *ptr, size_t size, size_t num)
+{
+    return 0;
+}
+
+static int SDLCALL app_close(SDL_RWops *rw)
+{
+    SDL_FreeRW(rw);
+    return 0;
+}
+
+/* kind is 0 for a memory RWops, 1 for an app RWops with a size, 2 for one without. */
+static void TimeLoads(const Uint8 *source, size_t size, int kind, int iterations)
+{
+    static const char *kinds[] = { "memory RWops", "app RWops", "app RWops, no size" };
+    Uint64 start, elapsed;
+    AppData app;
+    int reads = 0;
+    int i;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        SDL_RWops *rw;
+        size_t datasize = 0;
+        void *data;
+
+        SDL_zero(app);
+        app.mem = SDL_RWFromConstMem(source, (int)size);
+        if (kind == 0) {
+            rw = app.mem;
+        } else {
+            rw = SDL_AllocRW();
+            if (!rw) {
+                SDL_Log("Couldn't allocate RWops: %s", SDL_GetError());
+                SDL_RWclose(app.mem);
+                return;
+            }
+            app.has_size = (kind == 1) ? SDL_TRUE : SDL_FALSE;
+            rw->size = app_size;
+            rw->seek = app_seek;
+            rw->read = app_read;
+            rw->write = app_write;
+            rw->close = app_close;
+            rw->hidden.unknown.data1 = &app;
+        }
+
+        data = SDL_LoadFile_RW(rw, &datasize, 1);
+        if (!data || datasize != size) {
+            SDL_Log("SDL_LoadFile_RW() from %s failed: %s", kinds[kind], data ? "wrong size" : SDL_GetError());
+            SDL_free(data);
+            if (kind != 0) {
+                SDL_RWclose(app.mem);
+            }
+            return;
+        }
+        SDL_free(data);
+        if (kind != 0) {
+            SDL_RWclose(app.mem);
+        }
+        reads += app.reads;
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (kind == 0) {
+        SDL_Log("%9d bytes from %-20s %.3f ms per load",
+                (int)size, kinds[kind], (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency() / iterations);
+    } else {
+        SDL_Log("%9d bytes from %-20s %.3f ms per load, %d reads per load",
+                (int)size, kinds[kind], (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency() / iterations, reads / iterations);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = { 4 * 1024, 256 * 1024, 16 * 1024 * 1024 };
+    int iterations = 100;
+    Uint8 *source;
+    int i, kind;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+        if (iterations <= 0) {
+            SDL_Log("Usage: %s [iterations]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    source = (Uint8 *)SDL_malloc(sizes[SDL_arraysize(sizes) - 1]);
+    if (!source) {
+        SDL_Log("Out of memory");
+        SDL_Quit();
+        return 1;
+    }
+    for (i = 0; i < (int)sizes[SDL_arraysize(sizes) - 1]; i++) {
+        source[i] = (Uint8)(i * 7);
+    }
+
+    for (i = 0; i < (int)SDL_arraysize(sizes); i++) {
+        for (kind = 0; kind < 3; kind++) {
+            TimeLoads(source, sizes[i], kind, iterations);
+        }
+    }
+
+    SDL_free(source);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times SDL_LoadWAV_RW() on WAVs built in memory. 16-bit and float WAVs are read straight into the
+   returned buffer by sdl2-compat, 24-bit ones are decoded by SDL3, for comparison.
+   Usage: testloadwavspeed [seconds of audio] */
+
+#include "SDL.h"
+
+/* Builds a stereo 48kHz WAV with a LIST chunk before the data, like most editors write. */
+static Uint8 *BuildWAV(Uint16 tag, Uint16 bits, int seconds, size_t *len)
+{
+    const Uint32 data_len = (Uint32)seconds * 48000 * 2 * (bits / 8);
+    Uint8 *wav;
+    Uint8 *p;
+    Uint32 i;
+
+    *len = 12 + 24 + 16 + 8 + data_len;
+    wav = (Uint8 *)SDL_malloc(*len);
+    if (!wav) {
+        return NULL;
+    }
+    p = wav;
+#define PUT32(x) do { Uint32 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p[2] = (Uint8)(v_ >> 16); p[3] = (Uint8)(v_ >> 24); p += 4; } while (0)
+#define PUT16(x) do { Uint16 v_ = (x); p[0] = (Uint8)v_; p[1] = (Uint8)(v_ >> 8); p += 2; } while (0)
+    SDL_memcpy(p, "RIFF", 4); p += 4;
+    PUT32((Uint32)(*len - 8));
+    SDL_memcpy(p, "WAVE", 4); p += 4;
+    SDL_memcpy(p, "fmt ", 4); p += 4;
+    PUT32(16);
+    PUT16(tag);
+    PUT16(2);
+    PUT32(48000);
+    PUT32(48000 * 2 * (bits / 8));
+    PUT16((Uint16)(2 * (bits / 8)));
+    PUT16(bits);
+    SDL_memcpy(p, "LIST", 4); p += 4;
+    PUT32(8);
+    SDL_memcpy(p, "INFOISFT", 8); p += 8;
+    SDL_memcpy(p, "data", 4); p += 4;
+    PUT32(data_len);
+#undef PUT16
+#undef PUT32
+    for (i = 0; i < data_len; i++) {
+        p[i] = (Uint8)(i * 13);
+    }
+    if (tag == 3) {
+        /* keep the samples finite, in case anything looks at them. */
+        for (i = 3; i < data_len; i += 4) {
+            p[i] &= 0x3F;
+        }
+    }
+    return wav;
+}
+
+static void TimeLoads(const char *name, Uint16 tag, Uint16 bits, int seconds)
+{
+    const int iterations = 10;
+    Uint64 start, elapsed;
+    size_t len = 0;
+    Uint8 *wav = BuildWAV(tag, bits, seconds, &len);
+    int i;
+
+    if (!wav) {
+        SDL_Log("Out of memory");
+        return;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        SDL_AudioSpec spec;
+        Uint8 *audio_buf = NULL;
+        Uint32 audio_len = 0;
+
+        if (!SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, (int)len), 1, &spec, &audio_buf, &audio_len)) {
+            SDL_Log("Couldn't load %s WAV: %s", name, SDL_GetError());
+            SDL_free(wav);
+            return;
+        }
+        SDL_FreeWAV(audio_buf);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_Log("%-8s %d seconds: %.2f ms per load, %.0f MB/s", name, seconds,
+            (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency() / iterations,
+            ((double)len * iterations / (1024.0 * 1024.0)) / ((double)elapsed / SDL_GetPerformanceFrequency()));
+    SDL_free(wav);
+}
+
+int main(int argc, char *argv[])
+{
+    int seconds = 60;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        seconds = SDL_atoi(argv[1]);
+        if (seconds <= 0) {
+            SDL_Log("Usage: %s [seconds of audio]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    TimeLoads("16-bit", 1, 16, seconds);
+    TimeLoads("float", 3, 32, seconds);
+    TimeLoads("24-bit", 1, 24, seconds);
+
+    SDL_Quit();
+    return 0;
+}
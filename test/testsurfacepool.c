@@ -0,0 +1,69 @@
+/*
+  Copyright (C) 1997-2026 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times creating and freeing small surfaces, the way text renderers do every frame,
+   with sdl2-compat's surface pool on and off.
+   Usage: testsurfacepool [iterations] */
+
+#include "SDL.h"
+
+static void TimeCreateFree(SDL_bool pool, int iterations)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_SetHint("SDL2COMPAT_SURFACE_POOL", pool ? "1" : "0");
+    if (SDL_Init(0) < 0) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        /* a few live at once, like the strings on one screen. */
+        SDL_Surface *surfaces[4];
+        int j;
+        for (j = 0; j < (int)SDL_arraysize(surfaces); j++) {
+            surfaces[j] = SDL_CreateRGBSurfaceWithFormat(0, 64 + j, 16, 32, SDL_PIXELFORMAT_ARGB8888);
+        }
+        for (j = 0; j < (int)SDL_arraysize(surfaces); j++) {
+            SDL_FreeSurface(surfaces[j]);
+        }
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    SDL_Log("pool %-3s %d x 4 surfaces in %.2f ms, %.1f ns per create and free",
+            pool ? "on" : "off", iterations, (double)elapsed * 1000.0 / SDL_GetPerformanceFrequency(),
+            (double)elapsed * 1e9 / SDL_GetPerformanceFrequency() / ((double)iterations * 4));
+
+    /* SDL_Quit empties the pool, and the hint is checked again afterwards. */
+    SDL_Quit();
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = 250000;
+
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+        if (iterations <= 0) {
+            SDL_Log("Usage: %s [iterations]", argv[0]);
+            return 1;
+        }
+    }
+
+    TimeCreateFree(SDL_TRUE, iterations);
+    TimeCreateFree(SDL_FALSE, iterations);
+    return 0;
+}